@@ -41,7 +41,7 @@
 #include <glib.h>       // GString, GArray, GPtrArray, guint64, ..
 //#include <gio/gio.h>    // gsetbuf()
 #include <glib/gprintf.h> // g_sprintf()
-//#include <glib/gstdio.h>  // FILE
+#include <glib/gstdio.h>  // g_stat(), g_unlink()
 
 #include <unistd.h>      // getuid()
 //#include <sys/types.h>
@@ -140,6 +140,29 @@ typedef struct _cell {
     int        projDone;       // TRUE this cell has been projected
 #endif
 
+#ifdef S52_USE_CELL_CACHE
+    int        cacheDone;      // TRUE this cell is in the cache (loaded from or written to)
+    guint      cacheNPrim;     // number of tessellated object in the cache
+#endif
+
+#ifdef S52_USE_RTREE
+    // extent index of each renderBin - see _cullObj()
+    // Note: NULL or stale (not the same size as the renderBin) is rebuild at cull time
+    S57_rtree *rtree[S52_PRIO_NUM][S52_N_OBJ];
+#endif
+
+#ifdef S52_USE_CS_MP_DEP
+    // obj with a CS that read a Mariner Parameter - ref only, see _app()
+    // Note: NULL if no obj in this cell depend on this MP
+    GPtrArray *MPobjList[S52_MAR_NUM];
+#endif
+
+#ifdef S52_USE_AC_BATCH
+    // AC() of static area merged by prio/color - see _drawJournal()
+    S52_GL_ACbatch *acBatch;
+    int             acBatchDirty;   // TRUE if CS resolved since last build (color or prio may have change)
+#endif
+
     /*
     // optimisation - do CS only on obj affected by a change in a MP
     // instead of resolving the CS logic at render-time.
@@ -154,21 +177,24 @@ typedef struct _cell {
 
 } _cell;
 
+// Note: S52_USE_THREAD_LOAD - each cell is loaded by a worker thread, the state of
+// the cell being loaded is private to that thread (S52_TLS)
+
 // work buffer
 #ifdef S52_USE_SUPP_LINE_OVERLAP
-static guint      _baseRCID       = 0;     // offset of "ConnectedNode" (first primitive)
-static GPtrArray *_ConnectedNodes = NULL;  // Note: ConnectedNodes rcid are random in some case (CA4579016)
-static GPtrArray *_S57Edges       = NULL;  // final segment build from ENs and CNs
+static S52_TLS guint      _baseRCID       = 0;     // offset of "ConnectedNode" (first primitive)
+static S52_TLS GPtrArray *_ConnectedNodes = NULL;  // Note: ConnectedNodes rcid are random in some case (CA4579016)
+static S52_TLS GPtrArray *_S57Edges       = NULL;  // final segment build from ENs and CNs
 #endif
 
 #ifdef S52_USE_C_AGGR_C_ASSO
 // BBTree of key/value pair: LNAM --> geo (--> S57ID (for cursor pick))
 // BBTree of LANM 'key' with S57_geo as 'value'
-static GTree     *_lnamBBT      = NULL;
+static S52_TLS GTree     *_lnamBBT      = NULL;
 #endif  // S52_USE_C_AGGR_C_ASSO
 
 static GPtrArray *_cellList     = NULL;    // list of loaded cells - sorted, big to small scale (small to large region)
-static _cell     *_crntCell     = NULL;    // current cell (passed around when loading --FIXME: global var (dumb))
+static S52_TLS _cell *_crntCell = NULL;    // current cell (passed around when loading --FIXME: global var (dumb))
 static _cell     *_marinerCell  = NULL;    // place holder MIO's, and other (fake) S57 object
 #define MARINER_CELL   "--6MARIN.000"     // a chart purpose 6 (bellow knowm IHO chart purpose)
 #define WORLD_SHP_EXT  ".shp"             // shapefile ext
@@ -185,6 +211,12 @@ static int        _doInit       = TRUE;    // init the lib
 
 // FIXME: reparse CS of the affected MP only (ex: ship outline MP need only to reparse OWNSHP CS)
 static int        _APP_CS       = FALSE;   // TRUE will recreate *all* CS at next draw() or drawLast()
+#ifdef S52_USE_CS_MP_DEP
+static int        _APP_MP[S52_MAR_NUM];    // TRUE will recreate CS that read this Mariner Parameter at next _app()
+#define APP_CS_MP(paramID)  _APP_MP[paramID] = TRUE
+#else
+#define APP_CS_MP(paramID)  _APP_CS          = TRUE
+#endif
 static int        _APP_DATCVR   = FALSE;   // TRUE will compute HO Data Limit (CSP union), scale boundary, ..
 static int        _APP_RASTER   = FALSE;   // TRUE will compute raster texture
 
@@ -206,6 +238,44 @@ static char           *_intl        = NULL;    // setlocal()
 static guint           _nCull    = 0;
 static guint           _nTotal   = 0;
 
+#ifdef S52_USE_FRAME_STATS
+// rolling history of frame statistic (S52_getFrameStats())
+#define FRAME_STATS_HIST 128
+typedef struct _frameStat {
+    guint        frame;               // frame number
+    const char  *cycle;               // "draw" / "last"
+
+    // msec
+    gdouble      app;
+    gdouble      cull;
+    gdouble      draw;                // text excluded
+    gdouble      text;
+    gdouble      last;                // S52_drawLast() cull/draw layer 9
+    gdouble      end;                 // S52_GL_end()
+    gdouble      swap;                // EGL_END() - user CB
+    gdouble      total;
+    gdouble      layer[S52_PRIO_NUM]; // draw per display priority (included in draw)
+
+    guint        nTotal;              // obj tested
+    guint        nCull;               // obj culled
+    S52_GL_stat  gl;
+} _frameStat;
+static _frameStat      _frameStats[FRAME_STATS_HIST];
+static _frameStat      _frameCrnt;              // frame in progress
+static guint           _frameNo       = 0;      // number of frame recorded
+static gdouble         _frameMark     = 0.0;    // _timer at the end of the last stage
+static GString        *_frameStatsStr = NULL;   // JSON of S52_getFrameStats()
+#define FRAME_STAT(stage)   _frameStatMark(&_frameCrnt.stage)
+#else
+#define FRAME_STAT(stage)
+#endif
+
+#ifdef S52_USE_RTREE
+static ObjExt_t        _cullView;             // view extent of this cull (rotation included)
+static gboolean        _cullViewOK = FALSE;   // FALSE if view cross the anti-meridian (linear cull)
+static GArray         *_rtreeRes   = NULL;    // index of obj found in a renderBin
+#endif
+
 // CSYMB init scale bar, north arrow, unit, CHKSYM
 static int             _iniCSYMB = TRUE;
 
@@ -251,14 +321,65 @@ static void      *_EGLctx = NULL;
 
 #if (defined(S52_USE_ANDROID) || defined(_MINGW))
 static GStaticMutex  _mp_mutex = G_STATIC_MUTEX_INIT;
+#ifdef S52_USE_THREAD_LOAD
+static GStaticMutex  _load_mutex = G_STATIC_MUTEX_INIT;
+#endif
 #define GMUTEXLOCK   g_static_mutex_lock
 #define GMUTEXUNLOCK g_static_mutex_unlock
 #else
 static GMutex        _mp_mutex;
+#ifdef S52_USE_THREAD_LOAD
+static GMutex        _load_mutex;  // worker: guard _cellList while cells are loading (_mp_mutex held by caller)
+#endif
 #define GMUTEXLOCK   g_mutex_lock
 #define GMUTEXUNLOCK g_mutex_unlock
 #endif
 
+#ifdef S52_USE_THREAD_LOAD
+// base name of cells being loaded by a worker (not yet in _cellList) - guarded by _load_mutex
+static GHashTable   *_cellLoading = NULL;
+#endif
+
+#ifdef S52_USE_MAR_QUEUE
+// Mariners' Object update (S52_pushPosition(), S52_setVector(), S52_setVESSELstate(), S52_setVESSELlabel())
+// are queued by the caller thread and applied at the start of S52_draw() / S52_drawLast().
+// Two queues: caller append to one while draw apply the other - swap under _pend_mutex
+// so that drawing never wait on AIS/GPS thread and these never wait on a draw.
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex  _pend_mutex = G_STATIC_MUTEX_INIT;
+#else
+static GMutex        _pend_mutex;  // guard _pendQ append / swap only
+#endif
+#define PEND_MAX  65536            // nobody draw - caller apply the queue itself
+
+typedef enum _pendType {
+    _PEND_POS,    // S52_pushPosition()
+    _PEND_VEC,    // S52_setVector()
+    _PEND_LABEL,  // S52_setVESSELlabel()
+    _PEND_STATE,  // S52_setVESSELstate()
+} _pendType;
+
+typedef struct _pendUpd {
+    _pendType       type;
+    S52ObjectHandle objH;
+    double          d[3];   // POS: lat, lon, data - VEC: course, speed
+    int             i[3];   // VEC: vecstb - STATE: vesselSelect, vestat, vesselTurn
+    char           *str;    // LABEL: newLabel
+} _pendUpd;
+
+static GArray *_pendQ[2] = {NULL, NULL};  // _pendUpd
+static int     _pendW    = 0;             // index of the queue the callers append to
+
+static S52ObjectHandle _pendAdd(_pendType type, S52ObjectHandle objH, double d0, double d1, double d2,
+                                int i0, int i1, int i2, const char *str);  // forward decl
+static int        _pendApply(void);  // forward decl
+static int        _pendDone(void);   // forward decl
+#endif  // S52_USE_MAR_QUEUE
+
+#if defined(S52_USE_THREAD_PRJ) && defined(S52_USE_MERC_KERNEL)
+static int        _projectCellsDone(void);  // forward decl
+#endif
+
 // debug
 static const char *_mutexOwner      = NULL;
 static guint       _mutexOwnerS57ID = 0;
@@ -392,23 +513,24 @@ S52_MAR_DATUM_OFFSET
     // set APP() / CULL() flags
     switch (paramID) {
         // _SNDFRM02->OBSTRN04, WRECKS02;
-        case S52_MAR_SAFETY_DEPTH        : _APP_CS      = TRUE; break;
+        // Note: CS that read a MP - see S52_CS_readMP()
+        case S52_MAR_SAFETY_DEPTH        : APP_CS_MP(paramID);  break;
         // _SEABED01->DEPARE01;
-        case S52_MAR_SHALLOW_CONTOUR     : _APP_CS      = TRUE; break;
+        case S52_MAR_SHALLOW_CONTOUR     : APP_CS_MP(paramID);  break;
         // _SEABED01->DEPARE01;
-        case S52_MAR_TWO_SHADES          : _APP_CS      = TRUE; break;
+        case S52_MAR_TWO_SHADES          : APP_CS_MP(paramID);  break;
         // _SEABED01->DEPARE01;
-        case S52_MAR_SHALLOW_PATTERN     : _APP_CS      = TRUE; break;
-        case S52_MAR_SYMBOLIZED_BND      : _APP_CS      = TRUE; break;
+        case S52_MAR_SHALLOW_PATTERN     : APP_CS_MP(paramID);  break;
+        case S52_MAR_SYMBOLIZED_BND      : APP_CS_MP(paramID);  break;
 
         // DEPCNT02; _SEABED01->DEPARE01; _UDWHAZ03->OBSTRN04, WRECKS02;
-        case S52_MAR_SAFETY_CONTOUR      : _APP_CS      = TRUE;
+        case S52_MAR_SAFETY_CONTOUR      : APP_CS_MP(paramID);
                                            _APP_RASTER  = TRUE; break;
         // _SEABED01->DEPARE01;
-        case S52_MAR_DEEP_CONTOUR        : _APP_CS      = TRUE;
+        case S52_MAR_DEEP_CONTOUR        : APP_CS_MP(paramID);
                                            _APP_RASTER  = TRUE; break;
         // DEPARE01; DEPCNT02; _DEPVAL01; SLCONS03; _UDWHAZ03;
-        case S52_MAR_DATUM_OFFSET        : _APP_CS      = TRUE;
+        case S52_MAR_DATUM_OFFSET        : APP_CS_MP(paramID);
                                            _APP_RASTER  = TRUE; break;
 
         case S52_MAR_DISP_HODATA_UNION   : _CULL_hodata = TRUE; break;
@@ -559,6 +681,10 @@ static _cell     *_newCell(const char *filename)
 
         cell->projDone     = FALSE;
 
+#ifdef S52_USE_AC_BATCH
+        cell->acBatchDirty = TRUE;
+#endif
+
         /*
         cell->DEPARElist = g_ptr_array_new();
         cell->DEPCNTlist = g_ptr_array_new();
@@ -591,18 +717,126 @@ static void       _delObj(S52_obj *obj)
     return;
 }
 
+#ifdef S52_USE_RTREE
+static S57_rtree *_rtreeNew(GPtrArray *rbin)
+// index the extent of all obj in this renderBin
+{
+    ObjExt_t *ext = g_new(ObjExt_t, rbin->len + 1);
+    for (guint idx=0; idx<rbin->len; ++idx) {
+        S52_obj *obj = (S52_obj *)g_ptr_array_index(rbin, idx);
+        ext[idx] = S57_getGeoExt(S52_PL_getGeo(obj));
+    }
+
+    S57_rtree *rtree = S57_newRTree(ext, rbin->len);
+
+    g_free(ext);
+
+    return rtree;
+}
+
+static int        _rtreeDone(_cell *c)
+// Note: obj moved in / out of renderBin - index rebuild at next cull
+{
+    TRAV_RBIN_ij(c->rtree[i][j] = S57_doneRTree(c->rtree[i][j]));
+
+    return TRUE;
+}
+
+static int        _rtreeBuild(_cell *c)
+{
+    _rtreeDone(c);
+
+    TRAV_RBIN_ij(c->rtree[i][j] = _rtreeNew(c->renderBin[i][j]));
+
+    return TRUE;
+}
+#endif  // S52_USE_RTREE
+
+#ifdef S52_USE_CS_MP_DEP
+static int        _MPdepDone(_cell *c)
+{
+    for (int p=0; p<S52_MAR_NUM; ++p) {
+        if (NULL != c->MPobjList[p])
+            g_ptr_array_free(c->MPobjList[p], TRUE);
+        c->MPobjList[p] = NULL;
+    }
+
+    return TRUE;
+}
+
+static void       __addMPdep(S52_obj *obj, _cell *c)
+{
+    const char *CSnm0 = S52_PL_getCSnm(obj, 0);
+    const char *CSnm1 = S52_PL_getCSnm(obj, 1);
+
+    if ((NULL==CSnm0) && (NULL==CSnm1))
+        return;
+
+    for (int p=0; p<S52_MAR_NUM; ++p) {
+        if ((TRUE==S52_CS_readMP(CSnm0, (S52MarinerParameter)p)) ||
+            (TRUE==S52_CS_readMP(CSnm1, (S52MarinerParameter)p)))
+        {
+            if (NULL == c->MPobjList[p])
+                c->MPobjList[p] = g_ptr_array_new();
+            g_ptr_array_add(c->MPobjList[p], obj);
+        }
+    }
+
+    return;
+}
+
+static int        _MPdepBuild(_cell *c)
+// collect obj of this cell with a CS that read a Mariner Parameter
+// Note: not for the mariner cell - obj come and go
+{
+    _MPdepDone(c);
+
+    TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)__addMPdep, c));
+
+    return TRUE;
+}
+#endif  // S52_USE_CS_MP_DEP
+
+#ifdef S52_USE_CELL_CACHE
+static int        _cacheWriteCell(_cell *c);  // forward decl
+static guint      _cacheNPrim(_cell *c);      // forward decl
+#endif
 static void       _freeCell(_cell *c)
 {
+#ifdef S52_USE_CELL_CACHE
+    // save area tessellated since the cache was written
+    if ((TRUE==c->cacheDone) && (c->cacheNPrim<_cacheNPrim(c)))
+        _cacheWriteCell(c);
+
+    // projected lazily but never cached (ie cache write failed)
+    if ((TRUE==c->projDone) && (FALSE==c->cacheDone))
+        _cacheWriteCell(c);
+#endif
+
     if (NULL != c->filename)
         g_string_free(c->filename, TRUE);
     g_free(c->encPath);
 
+#ifdef S52_USE_AC_BATCH
+    // ref obj in renderBin
+    if (NULL != c->acBatch)
+        S52_GL_delACbatch(c->acBatch);
+#endif
+
     TRAV_RBIN_ij(g_ptr_array_free(c->renderBin[i][j], TRUE));
 
+#ifdef S52_USE_RTREE
+    _rtreeDone(c);
+#endif
+
     S52_CS_done(c->local);
 
     g_ptr_array_free(c->lights_sector, TRUE);
 
+#ifdef S52_USE_CS_MP_DEP
+    _MPdepDone(c);
+#endif
+
     // Note: all bellow are ref to obj - no free_func / _delObj() on array
     g_ptr_array_free(c->textList,      TRUE);
     g_ptr_array_free(c->objList_supp,  TRUE);
@@ -648,17 +882,55 @@ static int        _initPROJview(void)
 }
 
 //void (*GFunc) (gpointer data, gpointer user_data);
-static void       _S57_geo2prj(S52_obj *obj, gpointer dummy) {(void)dummy; S57_geo2prj(S52PLGETGEO(obj));}
+static void       _S57_geo2prj(S52_obj *obj, guint *nFail)
+{
+    S57_geo *geo = S52PLGETGEO(obj);
+
+    if (FALSE == S57_geo2prj(geo)) {
+        ++(*nFail);
+        return;
+    }
+
+#ifdef S52_USE_LINE_LOD
+    // here (projection / load worker) rather than on the render thread
+    S57_setGeoLOD(geo);
+#endif
+}
+static int        _projectCell(_cell *c)
+// Note: projDone stay FALSE if the projection is not set yet (the cell is projected later)
+{
+    if (NULL == S57_getPrjStr())
+        return FALSE;
+
+    guint nFail = 0;
+    TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)_S57_geo2prj, &nFail));
+
+    g_ptr_array_foreach(c->lights_sector, (GFunc)_S57_geo2prj, &nFail);
+
+    // Note: geo projected can't be projected again - a failed geo is left as is
+    if (0 != nFail) {
+        PRINTF("WARNING: %u geo of cell %s failed projection\n", nFail, c->filename->str);
+    }
+
+    c->projDone = TRUE;
+
+    return (0 == nFail) ? TRUE : FALSE;
+}
+
 static int        _projectCells(void)
 {
+#ifdef S52_USE_THREAD_PRJ
+    // ENC cells are projected when they first come into view - see _projectCellsInView()
+    if ((NULL!=_marinerCell) && (FALSE==_marinerCell->projDone))
+        _projectCell(_marinerCell);
+
+    return TRUE;
+#endif
+
     for (guint k=0; k<_cellList->len; ++k) {
         _cell *c = (_cell*) g_ptr_array_index(_cellList, k);
         if (FALSE == c->projDone) {
-            TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)_S57_geo2prj, NULL));
-
-            g_ptr_array_foreach(c->lights_sector, (GFunc)_S57_geo2prj, NULL);
-
-            c->projDone = TRUE;
+            _projectCell(c);
         }
     }
 
@@ -879,11 +1151,26 @@ DLL int    STD S52_done(void)
 {
     S52_CHECK_MUTX_INIT;
 
+#ifdef S52_USE_MAR_QUEUE
+    _pendDone();
+#endif
+
+#if defined(S52_USE_THREAD_PRJ) && defined(S52_USE_MERC_KERNEL)
+    _projectCellsDone();
+#endif
+
     // this call free_func() if set
     g_ptr_array_free(_cellList, TRUE);
     _cellList    = NULL;
     _marinerCell = NULL;
 
+#ifdef S52_USE_THREAD_LOAD
+    if (NULL != _cellLoading) {
+        g_hash_table_destroy(_cellLoading);
+        _cellLoading = NULL;
+    }
+#endif
+
     S52_GL_done();
     S52_PL_done();
 
@@ -896,6 +1183,13 @@ DLL int    STD S52_done(void)
     g_timer_destroy(_timer);
     _timer = NULL;
 
+#ifdef S52_USE_FRAME_STATS
+    if (NULL != _frameStatsStr) {
+        g_string_free(_frameStatsStr, TRUE);
+        _frameStatsStr = NULL;
+    }
+#endif
+
     _doInit = FALSE;
 
 #ifdef S52_USE_DBUS
@@ -933,6 +1227,13 @@ DLL int    STD S52_done(void)
     g_array_free(_sclbdUList, TRUE);
     _sclbdUList = NULL;
 
+#ifdef S52_USE_RTREE
+    if (NULL != _rtreeRes) {
+        g_array_free(_rtreeRes, TRUE);
+        _rtreeRes = NULL;
+    }
+#endif
+
 #ifdef S52_USE_EGL
     _eglBeg = NULL;
     _eglEnd = NULL;
@@ -1297,6 +1598,265 @@ static void       __dumpNODATAlayer(S52_obj *obj, gpointer dummy)
     return;
 }
 
+#ifdef S52_USE_CELL_CACHE
+// persistent cell cache: S57_geo projected, simplified, line overlap resolved and area tessellated
+// Note: valid for the same base cell/updates (path, size, time), projection and vertex type
+#define CACHE_MAGIC    "S52C"
+#define CACHE_VERSION  2   // 2: collinear point removed in metre, after projection
+#define CACHE_EXT      ".s52c"
+
+// first cell loaded from cache set the projection - its view is set by the caller thread of
+// S52_loadCell() (not a loading worker), see _cacheSetView()
+static _cell *_cacheViewCell = NULL;
+
+typedef struct _cacheHdr {
+    char     magic[4];
+    guint32  version;
+    guint32  vertexSz;      // sizeof(vertex_t) - GL1 and GL2 tessellation differ
+    guint32  stampLen;      // cell stamp lenght ('\0' included)
+    guint32  prjLen;        // projection string lenght ('\0' included)
+    guint32  classLen;      // S57ClassList lenght ('\0' included)
+} _cacheHdr;
+#define CACHE_ALIGN(n)  (((n) + 7) & ~7)
+
+static int        _loadS57geo(const char *objname, S57_geo *geo);  // forward decl
+
+static gchar     *_cachePath(const char *filename)
+// return cache file name or NULL if no cache dir in .cfg
+{
+    valueBuf cacheDir = {'\0'};
+    if (FALSE == S52_utils_getConfig(CFG_CACHE, cacheDir))
+        return NULL;
+
+    gchar *baseName = g_path_get_basename(filename);
+    gchar *cacheNm  = g_strconcat(baseName, CACHE_EXT, NULL);
+    gchar *path     = g_build_filename(g_strstrip(cacheDir), cacheNm, NULL);
+    g_free(cacheNm);
+    g_free(baseName);
+
+    return path;
+}
+
+static gchar     *_cacheStamp(const char *filename)
+// key of a cell: path, size and time of the base cell and its updates
+// Note: edition/update number (DSID) is only known after parsing the cell,
+// but a new edition or update change the size/time of these files
+{
+    GString *stamp = g_string_new(filename);
+    gchar   *base  = g_strndup(filename, strlen(filename) - 4);  // strip '.000'
+
+    for (int upd=0; upd<1000; ++upd) {
+        GStatBuf st;
+        gchar   *updName = g_strdup_printf("%s.%03i", base, upd);
+        int      ret     = g_stat(updName, &st);
+        g_free(updName);
+        if (0 != ret)
+            break;
+
+        g_string_append_printf(stamp, ";%03i:%li:%li", upd, (long)st.st_size, (long)st.st_mtime);
+    }
+    g_free(base);
+
+    return g_string_free(stamp, FALSE);
+}
+
+static void       __cacheGeo(S52_obj *obj, GByteArray *buf) {S57_geo2cache(S52_PL_getGeo(obj), buf);}
+static void       __cacheNPrim(S52_obj *obj, guint *n)     {if (NULL != S57_getPrimGeo(S52_PL_getGeo(obj))) ++(*n);}
+static guint      _cacheNPrim(_cell *c)
+{
+    guint n = 0;
+
+    TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)__cacheNPrim, &n));
+
+    return n;
+}
+
+static int        _cacheWriteCell(_cell *c)
+{
+    // only S57 base cell, projected
+    if ((NULL==c->encPath) || (FALSE==g_str_has_suffix(c->encPath, ".000")))
+        return FALSE;
+    if ((FALSE==c->projDone) || (NULL==S57_getPrjStr()))
+        return FALSE;
+
+    gchar *path = _cachePath(c->encPath);
+    if (NULL == path)
+        return FALSE;
+
+    gchar      *stamp = _cacheStamp(c->encPath);
+    CCHAR      *prj   = S57_getPrjStr();
+    GByteArray *buf   = g_byte_array_new();
+    _cacheHdr   hdr;
+
+    memcpy(hdr.magic, CACHE_MAGIC, 4);
+    hdr.version  = CACHE_VERSION;
+    hdr.vertexSz = sizeof(vertex_t);
+    hdr.stampLen = strlen(stamp) + 1;
+    hdr.prjLen   = strlen(prj)   + 1;
+    hdr.classLen = c->S57ClassList->len + 1;
+
+    g_byte_array_append(buf, (const guint8*)&hdr,                 sizeof(hdr));
+    g_byte_array_append(buf, (const guint8*)stamp,                hdr.stampLen);
+    g_byte_array_append(buf, (const guint8*)prj,                  hdr.prjLen);
+    g_byte_array_append(buf, (const guint8*)c->S57ClassList->str, hdr.classLen);
+    {   // align first record
+        static const guint8 zero[8] = {0};
+        g_byte_array_append(buf, zero, CACHE_ALIGN(buf->len) - buf->len);
+    }
+
+    TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)__cacheGeo, buf));
+    g_ptr_array_foreach(c->lights_sector, (GFunc)__cacheGeo, buf);
+
+    GError *error = NULL;
+    if (FALSE == g_file_set_contents(path, (const gchar*)buf->data, buf->len, &error)) {
+        PRINTF("WARNING: writing cell cache %s failed (%s)\n", path, error->message);
+        g_error_free(error);
+    } else {
+        c->cacheDone  = TRUE;
+        c->cacheNPrim = _cacheNPrim(c);
+        PRINTF("DEBUG: cell cache written: %s (%u bytes)\n", path, buf->len);
+    }
+
+    g_byte_array_free(buf, TRUE);
+    g_free(stamp);
+    g_free(path);
+
+    return c->cacheDone;
+}
+
+static int        _cacheSetView(void)
+// set the view on the cell that set the projection from the cache - caller thread
+{
+    if (NULL == _cacheViewCell)
+        return FALSE;
+
+    _cell *c     = _cacheViewCell;
+    double cLat  =  (c->geoExt.N + c->geoExt.S) / 2.0;
+    double cLon  =  (c->geoExt.W + c->geoExt.E) / 2.0;
+    double rNM   = ((c->geoExt.N - c->geoExt.S) / 2.0) * 60.0;
+    S52_GL_setView(cLat, cLon, rNM, 0.0);
+
+    _cacheViewCell = NULL;
+
+    return TRUE;
+}
+
+static int        _cacheReadCell(_cell *c, const char *filename)
+// load cell 'c' from the cache, return FALSE if no valid cache (nothing loaded)
+{
+    int        ret     = FALSE;
+    int        prjView = FALSE;  // TRUE projection set from cache, view need setting
+    gchar     *path    = _cachePath(filename);
+    gchar     *stamp   = NULL;
+    GPtrArray *geoList = NULL;   // S57_geo decoded from cache
+
+    if ((NULL==path) || (FALSE==g_str_has_suffix(filename, ".000")))
+        goto exit;
+
+    GMappedFile *mf = g_mapped_file_new(path, FALSE, NULL);
+    if (NULL == mf)
+        goto exit;
+
+    const guchar *data = (const guchar*)g_mapped_file_get_contents(mf);
+    const guchar *end  = data + g_mapped_file_get_length(mf);
+    _cacheHdr     hdr;
+
+    if (end < data + sizeof(hdr))
+        goto unmap;
+    memcpy(&hdr, data, sizeof(hdr));
+    if ((0!=memcmp(hdr.magic, CACHE_MAGIC, 4)) || (CACHE_VERSION!=hdr.version) || (sizeof(vertex_t)!=hdr.vertexSz))
+        goto unmap;
+    if (end < data + sizeof(hdr) + hdr.stampLen + hdr.prjLen + hdr.classLen)
+        goto unmap;
+
+    const char *cacheStamp = (const char *)data + sizeof(hdr);
+    const char *cachePrj   = cacheStamp + hdr.stampLen;
+    const char *cacheClass = cachePrj   + hdr.prjLen;
+
+    stamp = _cacheStamp(filename);
+    if (0 != g_strcmp0(stamp, cacheStamp)) {
+        PRINTF("NOTE: cell cache out of date: %s\n", path);
+        goto unmap;
+    }
+
+    // decode all record first - nothing is inserted in the cell if one is corrupted
+    data += CACHE_ALIGN(sizeof(hdr) + hdr.stampLen + hdr.prjLen + hdr.classLen);
+    geoList = g_ptr_array_new();
+    while (data < end) {
+        S57_geo *geo = S57_cache2geo(&data, end);
+        if (NULL == geo) {
+            PRINTF("WARNING: corrupted cell cache, deleted: %s\n", path);
+            g_unlink(path);
+            goto unmap;
+        }
+        g_ptr_array_add(geoList, geo);
+    }
+
+    {   // coordinates in cache are projected - projection must match
+#ifdef S52_USE_THREAD_LOAD
+        GMUTEXLOCK(&_load_mutex);
+#endif
+        int prjOK = FALSE;
+        if (NULL == S57_getPrjStr()) {
+            // first cell - use the projection of the cache
+            double lat, lon;
+            if (2 == sscanf(cachePrj, "+proj=merc +lat_ts=%lf +lon_0=%lf", &lat, &lon))
+                prjView = S57_setMercPrj(lat, lon);
+        }
+        if (0 == g_strcmp0(S57_getPrjStr(), cachePrj))
+            prjOK = TRUE;
+#ifdef S52_USE_THREAD_LOAD
+        GMUTEXUNLOCK(&_load_mutex);
+#endif
+        if (FALSE == prjOK) {
+            PRINTF("NOTE: cell cache projection mismatch: %s\n", path);
+            goto unmap;
+        }
+    }
+
+    g_string_assign(c->S57ClassList, cacheClass);
+
+    for (guint i=0; i<geoList->len; ++i) {
+        S57_geo *geo = (S57_geo *)g_ptr_array_index(geoList, i);
+#ifdef S52_USE_LINE_LOD
+        // coord in cache are projected - LOD as in _projectCell()
+        S57_setGeoLOD(geo);
+#endif
+        _loadS57geo(S57_getName(geo), geo);
+    }
+    g_ptr_array_set_size(geoList, 0);
+
+    c->projDone   = TRUE;
+    c->cacheDone  = TRUE;
+    c->cacheNPrim = _cacheNPrim(c);
+
+    // as _initPROJview() - skipped since projection is now set
+    // Note: only one cell set the projection - no lock, read after the loading workers join
+    if (TRUE == prjView)
+        _cacheViewCell = c;
+
+    PRINTF("NOTE: cell loaded from cache: %s\n", path);
+
+    ret = TRUE;
+
+unmap:
+    // not inserted in the cell (corrupted / mismatch) - caller fall back to OGR
+    if (NULL != geoList) {
+        for (guint i=0; i<geoList->len; ++i)
+            S57_doneData((S57_geo *)g_ptr_array_index(geoList, i), NULL);
+        g_ptr_array_free(geoList, TRUE);
+    }
+
+    g_mapped_file_unref(mf);
+
+exit:
+    g_free(stamp);
+    g_free(path);
+
+    return ret;
+}
+#endif  // S52_USE_CELL_CACHE
+
 static _cell     *_loadBaseCell(char *filename, S52_loadLayer_cb loadLayer_cb, S52_loadObject_cb loadObject_cb)
 {
     if ((FALSE==g_str_has_suffix(filename, ".000")) &&
@@ -1306,15 +1866,43 @@ static _cell     *_loadBaseCell(char *filename, S52_loadLayer_cb loadLayer_cb, S
         return NULL;
     }
 
+#ifdef S52_USE_THREAD_LOAD
+    // Note: a cell is in _cellList only when loaded - also check the cells still loading
+    GMUTEXLOCK(&_load_mutex);
+    _cell *c        = NULL;
+    gchar *baseName = g_path_get_basename(filename);
+    if (NULL == _cellLoading)
+        _cellLoading = g_hash_table_new(g_str_hash, g_str_equal);
+    if (NULL == g_hash_table_lookup(_cellLoading, baseName)) {
+        c = _newCell(filename);
+        if (NULL != c)
+            g_hash_table_insert(_cellLoading, c->filename->str, c);
+    } else {
+        // same cell loading on an other worker
+        _crntCell = NULL;
+    }
+    g_free(baseName);
+    GMUTEXUNLOCK(&_load_mutex);
+#else
     _cell *c = _newCell(filename);
+#endif
     if (NULL == c) {
         PRINTF("WARNING: _newCell() failed\n");
         //g_assert(0);
         return NULL;
     }
+
+    c->encPath = g_strdup(filename);
+
+#ifndef S52_USE_THREAD_LOAD
     g_ptr_array_add(_cellList, c);
     g_ptr_array_sort(_cellList, _cmpCellINTU);
+#endif
 
+#ifdef S52_USE_CELL_CACHE
+    if (FALSE == _cacheReadCell(c, filename))
+#endif
+    {
 #ifdef S52_USE_GV
     S57_gvLoadCell (filename, layer_cb);
 #else
@@ -1331,6 +1919,7 @@ static _cell     *_loadBaseCell(char *filename, S52_loadLayer_cb loadLayer_cb, S
 
     _suppLineOverlap();
 #endif
+    }
 
 #ifdef S52_USE_C_AGGR_C_ASSO
     TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j],  (GFunc)__linkRel2LNAM, NULL));
@@ -1355,9 +1944,115 @@ static _cell     *_loadBaseCell(char *filename, S52_loadLayer_cb loadLayer_cb, S
         PRINTF("DEBUG: NODATA Layer check -END-   ==============================================\n");
     }
 
+#ifdef S52_USE_RTREE
+    _rtreeBuild(c);
+#endif
+
+#ifdef S52_USE_CS_MP_DEP
+    _MPdepBuild(c);
+#endif
+
+#ifdef S52_USE_THREAD_LOAD
+#ifdef S52_USE_PROJ
+    // projection allready set (ie not the first load) - project this cell in the worker
+    // else _projectCells() will do it after all cells are loaded
+#ifndef S52_USE_THREAD_PRJ
+    // (with S52_USE_THREAD_PRJ _projectCellsInView() will, when the cell come into view)
+    if (NULL != S57_getPrjStr())
+        _projectCell(c);
+#endif
+#endif
+
+    // cell is complete - only now make it visible in _cellList
+    GMUTEXLOCK(&_load_mutex);
+    g_hash_table_remove(_cellLoading, c->filename->str);
+    g_ptr_array_add(_cellList, c);
+    g_ptr_array_sort(_cellList, _cmpCellINTU);
+    GMUTEXUNLOCK(&_load_mutex);
+#endif
+
     return c;
 }
 
+#ifdef S52_USE_THREAD_LOAD
+typedef struct _loadJob {
+    S52_loadLayer_cb  loadLayer_cb;
+    S52_loadObject_cb loadObject_cb;
+} _loadJob;
+
+static void       _loadCellWorker(gpointer data, gpointer user_data)
+// GThreadPool func - load one cell
+{
+    char     *encName = (char    *)data;
+    _loadJob *job     = (_loadJob*)user_data;
+
+    _loadBaseCell(encName, job->loadLayer_cb, job->loadObject_cb);
+
+    g_free(encName);
+
+    return;
+}
+
+static int        _loadCellPool(GPtrArray *encList, S52_loadLayer_cb loadLayer_cb, S52_loadObject_cb loadObject_cb)
+// load cells in parallel, one cell per worker
+// Note: caller hold _mp_mutex, worker only lock _load_mutex to insert the cell in _cellList
+// Note: take ownership of the names in encList
+{
+    _loadJob     job   = {loadLayer_cb, loadObject_cb};
+    GError      *error = NULL;
+    GThreadPool *pool  = g_thread_pool_new(_loadCellWorker, &job, g_get_num_processors(), TRUE, &error);
+    if (NULL == pool) {
+        PRINTF("WARNING: g_thread_pool_new() failed (%s)\n", (NULL==error) ? "" : error->message);
+        if (NULL != error)
+            g_error_free(error);
+
+        // fallback - load on this thread
+        for (guint i=0; i<encList->len; ++i)
+            _loadCellWorker(g_ptr_array_index(encList, i), &job);
+
+        return FALSE;
+    }
+
+    PRINTF("DEBUG: loading %u cells with %u threads\n", encList->len, g_get_num_processors());
+
+    for (guint i=0; i<encList->len; ++i)
+        g_thread_pool_push(pool, g_ptr_array_index(encList, i), NULL);
+
+    // wait for all cells
+    g_thread_pool_free(pool, FALSE, TRUE);
+
+    return TRUE;
+}
+
+#ifndef S52_USE_OGR_FILECOLLECTOR
+static int        _collectENC(const char *dirName, GPtrArray *encList)
+// walk ENC_ROOT, collect base cell (.000)
+{
+    GDir *dir = g_dir_open(dirName, 0, NULL);
+    if (NULL == dir)
+        return FALSE;
+
+    const gchar *name = NULL;
+    while (NULL != (name = g_dir_read_name(dir))) {
+        gchar *path = g_build_filename(dirName, name, NULL);
+        if (TRUE == g_file_test(path, G_FILE_TEST_IS_DIR)) {
+            _collectENC(path, encList);
+            g_free(path);
+        } else {
+            if (TRUE == g_str_has_suffix(path, ".000"))
+                g_ptr_array_add(encList, path);
+            else
+                g_free(path);
+        }
+    }
+
+    g_dir_close(dir);
+
+    return TRUE;
+}
+#endif  // !S52_USE_OGR_FILECOLLECTOR
+#endif  // S52_USE_THREAD_LOAD
+
 #ifdef S52_USE_OGR_FILECOLLECTOR
 // in libgdal.so
 // Note: must add 'extern "C"' to GDAL/OGR at S57.h:40
@@ -1825,11 +2520,19 @@ DLL int    STD S52_loadCell(const char *encPath, S52_loadObject_cb loadObject_cb
 
         char **encList = S57FileCollector(fname);
         if (NULL != encList) {
+#ifdef S52_USE_THREAD_LOAD
+            GPtrArray *encArr = g_ptr_array_new();
+            for (guint i=0; NULL!=encList[i]; ++i)
+                g_ptr_array_add(encArr, encList[i]);
+            _loadCellPool(encArr, loadLayer_cb, loadObject_cb);
+            g_ptr_array_free(encArr, TRUE);
+#else
             for (guint i=0; NULL!=encList[i]; ++i) {
                 char *encName = encList[i];
                 _loadBaseCell(encName, loadLayer_cb, loadObject_cb);
                 g_free(encName);
             }
+#endif
             g_free(encList);
         } else {
             PRINTF("WARNING: S57FileCollector(%s) return NULL\n", fname);
@@ -1837,11 +2540,29 @@ DLL int    STD S52_loadCell(const char *encPath, S52_loadObject_cb loadObject_cb
     }
 
 #else   // S52_USE_OGR_FILECOLLECTOR
+#ifdef S52_USE_THREAD_LOAD
+    // ENC_ROOT - load all base cell found
+    if (TRUE == g_file_test(fname, G_FILE_TEST_IS_DIR)) {
+        GPtrArray *encArr = g_ptr_array_new();
+        _collectENC(fname, encArr);
+        if (0 == encArr->len) {
+            PRINTF("WARNING: no base cell (.000) found in %s\n", fname);
+            g_ptr_array_free(encArr, TRUE);
+            goto exit;
+        }
+        _loadCellPool(encArr, loadLayer_cb, loadObject_cb);
+        g_ptr_array_free(encArr, TRUE);
+    } else
+#endif
     if (NULL == _loadBaseCell(fname, loadLayer_cb, loadObject_cb)) {
         goto exit;
     }
 #endif  // S52_USE_OGR_FILECOLLECTOR
 
+#ifdef S52_USE_CELL_CACHE
+    _cacheSetView();
+#endif
+
 #ifdef S52_USE_PROJ
     if (TRUE == _initPROJview()) {
         ret = _projectCells();
@@ -1850,6 +2571,15 @@ DLL int    STD S52_loadCell(const char *encPath, S52_loadObject_cb loadObject_cb
     }
 #endif  // S52_USE_PROJ
 
+#ifdef S52_USE_CELL_CACHE
+    // save new cells (area are tessellated later, at draw time, saved when the cell is freed)
+    for (guint k=0; k<_cellList->len; ++k) {
+        _cell *c = (_cell*) g_ptr_array_index(_cellList, k);
+        if (FALSE == c->cacheDone)
+            _cacheWriteCell(c);
+    }
+#endif
+
 
     // _app() specific to sector light
     _CULL_Lights = TRUE;
@@ -2378,31 +3108,9 @@ static S52_obj   *_insertS52obj(_cell *c, S52_obj *obj)
     return obj;
 }
 
-//DLL int    STD S52_loadObject(const char *objname, void *shape)
-int            S52_loadObject(const char *objname, void *shape)
+static int        _loadS57geo(const char *objname, S57_geo *geo)
+// insert a S57_geo in the current cell (from OGR or from the cell cache)
 {
-    S57_geo *geo = NULL;
-
-    if ((NULL==objname) || (NULL==shape)) {
-        PRINTF("WARNING: objname / shape NULL\n");
-        return FALSE;
-    }
-
-#ifdef S52_USE_GV
-    // debug: filter out metadata
-    if (0 == g_strcmp0("DSID", objname))
-        return FALSE;
-
-    geo = S57_gvLoadObject (objname, (void*)shape);
-#else
-    geo = S57_ogrLoadObject(objname, (void*)shape);
-#endif
-
-    if (NULL == geo) {
-        PRINTF("OBJNAME:%s skipped .. no geo\n", objname);
-        return FALSE;
-    }
-
     // set cell extent from each area object
     // Note: should be the same as CATALOG.03x
     if (S57__META_T != S57_getObjtype(geo)) {
@@ -2586,6 +3294,34 @@ int            S52_loadObject(const char *objname, void *shape)
     return TRUE;
 }
 
+//DLL int    STD S52_loadObject(const char *objname, void *shape)
+int            S52_loadObject(const char *objname, void *shape)
+{
+    S57_geo *geo = NULL;
+
+    if ((NULL==objname) || (NULL==shape)) {
+        PRINTF("WARNING: objname / shape NULL\n");
+        return FALSE;
+    }
+
+#ifdef S52_USE_GV
+    // debug: filter out metadata
+    if (0 == g_strcmp0("DSID", objname))
+        return FALSE;
+
+    geo = S57_gvLoadObject (objname, (void*)shape);
+#else
+    geo = S57_ogrLoadObject(objname, (void*)shape);
+#endif
+
+    if (NULL == geo) {
+        PRINTF("OBJNAME:%s skipped .. no geo\n", objname);
+        return FALSE;
+    }
+
+    return _loadS57geo(objname, geo);
+}
+
 
 //---------------------------------------------------
 //
@@ -2889,8 +3625,8 @@ static int        _appMoveObj(_cell *c, GPtrArray *tmpRenderBin)
     return TRUE;
 }
 
-static void       __findOPrioObj(GPtrArray *rbin)
-// find all obj that have prio override and move to _tmpRenderBin
+static void       __findOPrioObj(GPtrArray *rbin, GPtrArray *tmpRenderBin)
+// find all obj that have prio override and move to tmpRenderBin
 {
     guint idx = 0;
     while (idx<rbin->len) {
@@ -2903,7 +3639,7 @@ static void       __findOPrioObj(GPtrArray *rbin)
             rbin->len             -= 1;
             rbin->pdata[rbin->len] = NULL;
 
-            g_ptr_array_add(_tmpRenderBin, obj);
+            g_ptr_array_add(tmpRenderBin, obj);
         } else {
             ++idx;
         }
@@ -2912,6 +3648,103 @@ static void       __findOPrioObj(GPtrArray *rbin)
     return;
 }
 
+#ifdef S52_USE_CS_MP_DEP
+static void       __resetParseText(S52_obj *obj, gpointer dummy)
+{
+    (void)dummy;
+
+    S52_PL_resetParseText(obj);
+}
+#endif
+
+static int        _appCell(_cell *c, int *APP_MP, GPtrArray *tmpRenderBin)
+// resolve CS of obj in this cell - all if APP_MP is NULL,
+// else only obj with a CS that read a Mariner Parameter flagged in APP_MP
+// then move obj with a prio override to there renderBin
+{
+    if (NULL == APP_MP) {
+        // FIXME: no need to check mariner cell if all mariner CS is in GL (S52_MP_get(S52_MAR_VECMRK))
+        TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)S52_PL_resolveSMB, NULL));
+    }
+#ifdef S52_USE_CS_MP_DEP
+    else if (c == _marinerCell) {
+        // mariner obj come and go - resolve all
+        TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)S52_PL_resolveSMB, NULL));
+    } else {
+        // DRVAL1 and clearance text are ajusted to datum (see S52PL.c:_parseTEXT())
+        if (TRUE == APP_MP[S52_MAR_DATUM_OFFSET])
+            TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)__resetParseText, NULL));
+
+        for (int p=0; p<S52_MAR_NUM; ++p) {
+            if ((TRUE==APP_MP[p]) && (NULL!=c->MPobjList[p]))
+                g_ptr_array_foreach(c->MPobjList[p], (GFunc)S52_PL_resolveSMB, NULL);
+        }
+    }
+#endif
+
+    // move obj
+    TRAV_RBIN_ij(__findOPrioObj(c->renderBin[i][j], tmpRenderBin));
+
+#ifdef S52_USE_RTREE
+    // __findOPrioObj() shuffle renderBin
+    if (0 < tmpRenderBin->len)
+        _rtreeDone(c);
+#endif
+
+    _appMoveObj(c, tmpRenderBin);
+
+#ifdef S52_USE_AC_BATCH
+    // rebuild at next draw
+    c->acBatchDirty = TRUE;
+#endif
+
+    return TRUE;
+}
+
+#ifdef S52_USE_THREAD_APP
+static void       _appCellWorker(gpointer data, gpointer user_data)
+// GThreadPool func - APP one cell
+// Note: CS only touch obj of its own cell (S52_CS_touch()) - no obj shared between worker
+{
+    _cell     *c            = (_cell *)data;
+    int       *APP_MP       = (int   *)user_data;
+    GPtrArray *tmpRenderBin = g_ptr_array_new();
+
+    _appCell(c, APP_MP, tmpRenderBin);
+
+    g_ptr_array_free(tmpRenderBin, TRUE);
+
+    return;
+}
+
+static int        _appCellPool(int *APP_MP)
+// APP all cells in parallel, one cell per job
+// Note: caller hold _mp_mutex
+{
+    GError      *error = NULL;
+    GThreadPool *pool  = g_thread_pool_new(_appCellWorker, APP_MP, g_get_num_processors(), TRUE, &error);
+    if (NULL == pool) {
+        PRINTF("WARNING: g_thread_pool_new() failed (%s)\n", (NULL==error) ? "" : error->message);
+        if (NULL != error)
+            g_error_free(error);
+
+        // fallback - APP on this thread
+        for (guint k=0; k<_cellList->len; ++k)
+            _appCell((_cell*)g_ptr_array_index(_cellList, k), APP_MP, _tmpRenderBin);
+
+        return FALSE;
+    }
+
+    for (guint k=0; k<_cellList->len; ++k)
+        g_thread_pool_push(pool, g_ptr_array_index(_cellList, k), NULL);
+
+    // wait for all cells
+    g_thread_pool_free(pool, FALSE, TRUE);
+
+    return TRUE;
+}
+#endif  // S52_USE_THREAD_APP
+
 static S52ObjectHandle _delMarObj(S52ObjectHandle objH);  // forward decl
 static int        _app(void)
 // FIXME: doCSMar Mariner Only - time the cost of APP
@@ -2923,21 +3756,37 @@ static int        _app(void)
     // Test doesn't show that the logic for POIN_T in GL at render-time cost anything noticable.
     // So the idea to move back the CS logic into CS.c is an esthetic one!
     // 2 -
-    if (TRUE == _APP_CS) {
-        // 2.1 - reparse CS
-        // FIXME: no need to check mariner cell if all mariner CS is in GL (S52_MP_get(S52_MAR_VECMRK))
-        ALL_C_TRAV_RBIN_ij(g_ptr_array_foreach(c->renderBin[i][j], (GFunc)S52_PL_resolveSMB, NULL));
+    int *APP_MP = NULL;      // NULL: resolve all CS
+    int  doAPP  = _APP_CS;
+
+#ifdef S52_USE_CS_MP_DEP
+    // only CS that read a MP that has change
+    if (FALSE == _APP_CS) {
+        for (int p=0; p<S52_MAR_NUM; ++p) {
+            if (TRUE == _APP_MP[p]) {
+                APP_MP = _APP_MP;
+                doAPP  = TRUE;
+                break;
+            }
+        }
+    }
+#endif
 
+    if (TRUE == doAPP) {
+        // 2.1 - reparse CS
         // 2.2 - move obj
-        for (guint k=0; k<_cellList->len; ++k) {
-            _cell *c = (_cell*) g_ptr_array_index(_cellList, k);
-            TRAV_RBIN_ij(__findOPrioObj(c->renderBin[i][j]));
-
-            _appMoveObj(c, _tmpRenderBin);
-        }
+#ifdef S52_USE_THREAD_APP
+        _appCellPool(APP_MP);
+#else
+        for (guint k=0; k<_cellList->len; ++k)
+            _appCell((_cell*)g_ptr_array_index(_cellList, k), APP_MP, _tmpRenderBin);
+#endif
 
         // done rebuilding CS
         _APP_CS = FALSE;
+#ifdef S52_USE_CS_MP_DEP
+        memset(_APP_MP, 0, sizeof(_APP_MP));
+#endif
     }
 
     // 2.3 - texApha, when raster is bathy,
@@ -3005,6 +3854,114 @@ static int        _resetJournal(void)
     return TRUE;
 }
 
+#ifdef S52_USE_THREAD_PRJ
+static void       _projectCellCache(_cell *c)
+// project a cell that came into view - then cache it
+// (S52_loadCell() can't write the cache of a cell not yet projected)
+{
+    _projectCell(c);
+
+#ifdef S52_USE_CELL_CACHE
+    if (FALSE == c->cacheDone)
+        _cacheWriteCell(c);
+#endif
+
+    return;
+}
+
+#ifdef S52_USE_MERC_KERNEL
+// persistent pool - cells coming into view together are projected in parallel
+// Note: without S52_USE_MERC_KERNEL every pj_transform() is serialized by PRJ_LOCK (S57data.c)
+//       so a pool would project one cell at a time - cells are then projected on this thread
+static GThreadPool *_prjPool = NULL;
+static GAsyncQueue *_prjDone = NULL;  // _cell * projected by a worker
+
+static void       _projectCellWorker(gpointer data, gpointer user_data)
+// GThreadPool func - project one cell
+// Note: a worker only touch the geo of its own cell (and its own cache file)
+{
+    (void)user_data;
+
+    _projectCellCache((_cell *)data);
+
+    g_async_queue_push(_prjDone, data);
+
+    return;
+}
+
+static int        _projectCellsDone(void)
+{
+    if (NULL != _prjPool) {
+        g_thread_pool_free(_prjPool, FALSE, TRUE);
+        _prjPool = NULL;
+    }
+    if (NULL != _prjDone) {
+        g_async_queue_unref(_prjDone);
+        _prjDone = NULL;
+    }
+
+    return TRUE;
+}
+#endif  // S52_USE_MERC_KERNEL
+
+static int        _projectCellsInView(ObjExt_t ext)
+// project, in parallel, the cells that intersect ext and are not projected yet
+// return the number of cells projected
+{
+    GPtrArray *prjList = NULL;
+
+    // skip mariner cell (idx 0)
+    for (guint i=_cellList->len-1; i>0; --i) {
+        _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
+        if ((FALSE==c->projDone) && (TRUE==_intersectCELL(c->geoExt, ext))) {
+            if (NULL == prjList)
+                prjList = g_ptr_array_new();
+            g_ptr_array_add(prjList, c);
+        }
+    }
+
+    if (NULL == prjList)
+        return 0;
+
+    guint n = prjList->len;
+
+#ifdef S52_USE_MERC_KERNEL
+    // first time - start the pool (not exclusive, threads are shared with glib)
+    if ((1 < n) && (NULL == _prjDone)) {
+        GError *error = NULL;
+
+        _prjDone = g_async_queue_new();
+        _prjPool = g_thread_pool_new(_projectCellWorker, NULL, g_get_num_processors(), FALSE, &error);
+        if (NULL == _prjPool) {
+            PRINTF("WARNING: g_thread_pool_new() failed (%s)\n", (NULL==error) ? "" : error->message);
+            if (NULL != error)
+                g_error_free(error);
+        }
+    }
+
+    if ((1 < n) && (NULL != _prjPool)) {
+        for (guint k=0; k<n; ++k)
+            g_thread_pool_push(_prjPool, g_ptr_array_index(prjList, k), NULL);
+
+        // wait for all cells - they are drawn in this frame
+        for (guint k=0; k<n; ++k)
+            g_async_queue_pop(_prjDone);
+    } else
+#endif
+    {
+        // one cell or no pool - project on this thread
+        for (guint k=0; k<n; ++k)
+            _projectCellCache((_cell*)g_ptr_array_index(prjList, k));
+    }
+
+    g_ptr_array_free(prjList, TRUE);
+
+    PRINTF("DEBUG: %i cell(s) projected\n", n);
+
+    return n;
+}
+#endif  // S52_USE_THREAD_PRJ
+
 static int        _cullLights(void)
 // CULL (first draw() after APP, on all cells)
 {
@@ -3044,13 +4001,29 @@ static int        _cullLights(void)
     return TRUE;
 }
 
-static int        _cullObj(_cell *c, GPtrArray *rbin)
+static int        _cullObj(_cell *c, GPtrArray *rbin, S57_rtree *rtree)
 //static int        _cullObj(S52_obj *obj, _cell *c)
 // cull object out side the view and object supressed
 // object culled are not inserted in the list of object to draw (journal)
+// Note: rtree NULL - test all obj in rbin
 {
+    guint  n       = rbin->len;
+    guint *idxList = NULL;
+
+#ifdef S52_USE_RTREE
+    // only obj that intersect the view - _nTotal count obj tested
+    if ((NULL!=rtree) && (TRUE==_cullViewOK)) {
+        g_array_set_size(_rtreeRes, 0);
+        n       = S57_queryRTree(rtree, _cullView, _rtreeRes);
+        idxList = (guint *)_rtreeRes->data;
+    }
+#else
+    (void)rtree;
+#endif
+
     // for each object
-    for (guint idx=0; idx<rbin->len; ++idx) {
+    for (guint k=0; k<n; ++k) {
+        guint    idx = (NULL == idxList) ? k : idxList[k];
         S52_obj *obj = (S52_obj *)g_ptr_array_index(rbin, idx);
 
         // debug: can this happen!
@@ -3152,14 +4125,23 @@ static int        _cullLayer(_cell *c)
         for (S52ObjectType j=S52__META; j<S52_N_OBJ; ++j) {
 
             GPtrArray *c_rbin = c->renderBin[i][j];
-            _cullObj(c, c_rbin);
+#ifdef S52_USE_RTREE
+            if (S57_getRTreeSize(c->rtree[i][j]) != c_rbin->len) {
+                S57_doneRTree(c->rtree[i][j]);
+                c->rtree[i][j] = _rtreeNew(c_rbin);
+            }
+            _cullObj(c, c_rbin, c->rtree[i][j]);
+#else
+            _cullObj(c, c_rbin, NULL);
+#endif
 
             //_cullObj(c_rbin, c);
             //foreach(c->renderBin[i][j], _cullObj, c);
 
 
+            // Note: mariner obj move (AIS, ownshp, ..) - no index
             GPtrArray *m_rbin = _marinerCell->renderBin[i][j];
-            _cullObj(c, m_rbin);
+            _cullObj(c, m_rbin, NULL);
 
             //_cullObj(m_rbin, c);
             //foreach(_marinerCell->renderBin[i][j], _cullObj, c);
@@ -3221,6 +4203,28 @@ static int        _cull(ObjExt_t ext)
     //PRINTF("DEBUG: LLv, LLu, URv, URu: %f %f  %f %f\n", LLv-dLat, LLu-dLon, URv+dLat, URu+dLat);
     //*/
 
+#ifdef S52_USE_RTREE
+    // query renderBin index with the same view as S52_GL_isOFFview()
+    {
+        double S, W, N, E;
+        S52_GL_getGEOView(&S, &W, &N, &E);
+        _cullView.W = W;
+        _cullView.S = S;
+        _cullView.E = E;
+        _cullView.N = N;
+        // anti-meridian - linear cull
+        _cullViewOK = (W <= E) ? TRUE : FALSE;
+
+        if (NULL == _rtreeRes)
+            _rtreeRes = g_array_new(FALSE, FALSE, sizeof(guint));
+    }
+#endif
+
+#ifdef S52_USE_THREAD_PRJ
+    // cells coming into view
+    _projectCellsInView(ext);
+#endif
+
     // all cells - larger region first (small scale)
     for (guint i=_cellList->len-1; i>0; --i) {
         _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
@@ -3277,10 +4281,18 @@ static int        _drawRaster(void)
 static int        _drawLayer(ObjExt_t ext, int layer)
 // debug
 {
+#ifdef S52_USE_FRAME_STATS
+    gdouble t0 = g_timer_elapsed(_timer, NULL);
+#endif
+
     // all cells --larger region first
     for (guint i=_cellList->len-1; i>0; --i) {
         _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
 
+        // not projected yet (S52_USE_THREAD_PRJ)
+        if (FALSE == c->projDone)
+            continue;
+
         if (TRUE == _intersectCELL(c->geoExt, ext)) {
 
             // one layer
@@ -3312,6 +4324,10 @@ static int        _drawLayer(ObjExt_t ext, int layer)
         }
     }
 
+#ifdef S52_USE_FRAME_STATS
+    _frameCrnt.layer[layer] += (g_timer_elapsed(_timer, NULL) - t0) * 1000.0;
+#endif
+
     return TRUE;
 }
 
@@ -3547,6 +4563,110 @@ static int        _drawLegend(void)
     return TRUE;
 }
 
+#ifdef S52_USE_FRAME_STATS
+static int        _frameStatBeg(const char *cycle)
+// Note: _timer reset by caller
+{
+    memset(&_frameCrnt, 0, sizeof(_frameStat));
+    _frameCrnt.cycle = cycle;
+    _frameMark       = 0.0;
+
+    return TRUE;
+}
+
+static int        _frameStatMark(gdouble *stage)
+// add time since last mark to this stage
+{
+    gdouble now = g_timer_elapsed(_timer, NULL);
+    *stage    += (now - _frameMark) * 1000.0;
+    _frameMark = now;
+
+    return TRUE;
+}
+
+static int        _frameStatEnd(S52_GL_cycle cycle)
+// push frame in history
+{
+    _frameCrnt.total  = g_timer_elapsed(_timer, NULL) * 1000.0;
+    _frameCrnt.nTotal = _nTotal;
+    _frameCrnt.nCull  = _nCull;
+    _frameCrnt.frame  = _frameNo;
+    S52_GL_getStat(cycle, &_frameCrnt.gl);
+
+    _frameStats[_frameNo % FRAME_STATS_HIST] = _frameCrnt;
+    ++_frameNo;
+
+    return TRUE;
+}
+#endif  // S52_USE_FRAME_STATS
+
+#ifdef S52_USE_AC_BATCH
+static int        _buildACbatch(_cell *c)
+// merge AC() of static area of this cell - obj that can't be merged are drawn alone
+{
+    if (NULL != c->acBatch)
+        S52_GL_delACbatch(c->acBatch);
+    c->acBatch = S52_GL_newACbatch();
+
+    // Note: mariner obj are dynamic
+    for (S52_disPrio i=S52_PRIO_NODATA; i<S52_PRIO_MARINR; ++i) {
+        GPtrArray *rbin = c->renderBin[i][S52_AREAS];
+        for (guint k=0; k<rbin->len; ++k)
+            S52_GL_addACbatch(c->acBatch, (S52_obj *)g_ptr_array_index(rbin, k));
+    }
+    S52_GL_endACbatch(c->acBatch);
+
+    c->acBatchDirty = FALSE;
+
+    return TRUE;
+}
+#endif
+
+static int        _drawJournal(_cell *c, GPtrArray *journal)
+// render journal (sorted by display priority)
+{
+#if defined(S52_USE_FRAME_STATS) || defined(S52_USE_AC_BATCH) || defined(S52_USE_SY_INST)
+    // one segment per display priority - batched AC() first, then obj, then queued SY() (timed)
+    guint beg = 0;
+    while (beg < journal->len) {
+        S52_disPrio prio = S52_PL_getDPRI((S52_obj *)g_ptr_array_index(journal, beg));
+        guint       end  = beg + 1;
+        while ((end<journal->len) && (prio==S52_PL_getDPRI((S52_obj *)g_ptr_array_index(journal, end))))
+            ++end;
+
+#ifdef S52_USE_FRAME_STATS
+        gdouble t0 = g_timer_elapsed(_timer, NULL);
+#endif
+
+#ifdef S52_USE_AC_BATCH
+        S52_GL_drawACbatch(c->acBatch, journal, beg, end);
+#endif
+        for (guint i=beg; i<end; ++i)
+            S52_GL_draw((S52_obj *)g_ptr_array_index(journal, i), NULL);
+
+#ifdef S52_USE_SY_INST
+        S52_GL_flushSY();
+#endif
+
+#ifdef S52_USE_FRAME_STATS
+        _frameCrnt.layer[prio] += (g_timer_elapsed(_timer, NULL) - t0) * 1000.0;
+#endif
+
+        beg = end;
+    }
+
+#ifdef S52_USE_AC_BATCH
+    S52_GL_drawACbatch(NULL, NULL, 0, 0);
+#endif
+#else
+    g_ptr_array_foreach(journal, (GFunc)S52_GL_draw, NULL);
+#endif
+
+    (void)c;
+
+    return TRUE;
+}
+
 static int        _draw(void)
 // draw object inside view
 // then draw object's text
@@ -3560,6 +4680,12 @@ static int        _draw(void)
     for (guint i=_cellList->len-1; i>0; --i) {
         _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
 
+#ifdef S52_USE_THREAD_PRJ
+        // not yet in view - nothing culled, no GPU buffer
+        if (FALSE == c->projDone)
+            continue;
+#endif
+
         int atomicAbort = S52_utils_getAtomicInt();
         //g_atomic_int_get(&_atomicAbort);
         if (TRUE == atomicAbort) {
@@ -3600,8 +4726,13 @@ static int        _draw(void)
             //*/
         }
 
+#ifdef S52_USE_AC_BATCH
+        if (TRUE == c->acBatchDirty)
+            _buildACbatch(c);
+#endif
+
         // draw under radar
-        g_ptr_array_foreach(c->objList_supp, (GFunc)S52_GL_draw, NULL);
+        _drawJournal(c, c->objList_supp);
 
         // USE_RASTER/RADAR
 #if defined(S52_USE_GL2)    || defined(S52_USE_GLES2)
@@ -3614,13 +4745,18 @@ static int        _draw(void)
 #endif
 #endif
         // draw over radar
-        g_ptr_array_foreach(c->objList_over, (GFunc)S52_GL_draw, NULL);
+        _drawJournal(c, c->objList_over);
 
         // end scissor test
         S52_GL_setScissor(0, 0, -1, -1);
+        FRAME_STAT(draw);
 
         // draw text
         g_ptr_array_foreach(c->textList,     (GFunc)S52_GL_drawText, NULL);
+#ifdef S52_USE_TXT_BATCH
+        S52_GL_flushTXT();
+#endif
+        FRAME_STAT(text);
     }
 
     return TRUE;
@@ -3650,12 +4786,20 @@ DLL int    STD S52_draw(void)
 
     S52_CHECK_INIT;
 
+#ifdef S52_USE_MAR_QUEUE
+    // Mariners' Object update queued since last frame
+    _pendApply();
+#endif
+
     EGL_BEG(DRAW);
 
     if (NULL == S57_getPrjStr())
         goto exit;
 
     g_timer_reset(_timer);
+#ifdef S52_USE_FRAME_STATS
+    _frameStatBeg("draw");
+#endif
 
     // debug
     //PRINTF("DRAW: start ..\n");
@@ -3667,6 +4811,7 @@ DLL int    STD S52_draw(void)
         //////////////////////////////////////////////
         // APP:  .. update object
         _app();
+        FRAME_STAT(app);
 
         //////////////////////////////////////////////
         // CULL: .. supress display of object (eg outside view)
@@ -3705,6 +4850,7 @@ DLL int    STD S52_draw(void)
         _cull(ext);
 
         _cullLights();
+        FRAME_STAT(cull);
 
         //PRINTF("S52_draw() .. -1.3-\n");
 
@@ -3720,6 +4866,9 @@ DLL int    STD S52_draw(void)
                 if (S52_PRIO_HAZRDS == layer) {
                     for (guint i=_cellList->len-1; i>0; --i) {
                         _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
+                        // lights of a cell never in view are still in deg (S52_USE_THREAD_PRJ)
+                        if (FALSE == c->projDone)
+                            continue;
                         g_ptr_array_foreach(c->lights_sector, (GFunc)_drawLights, NULL);
                     }
                     //_drawLights();
@@ -3732,6 +4881,9 @@ DLL int    STD S52_draw(void)
             // complete leg extend from lights outside view
             for (guint i=_cellList->len-1; i>0; --i) {
                 _cell *c = (_cell*) g_ptr_array_index(_cellList, i);
+                // lights of a cell never in view are still in deg (S52_USE_THREAD_PRJ)
+                if (FALSE == c->projDone)
+                    continue;
                 g_ptr_array_foreach(c->lights_sector, (GFunc)_drawLights, NULL);
             }
             //_drawLights();
@@ -3746,8 +4898,10 @@ DLL int    STD S52_draw(void)
         // draw legend
         if (TRUE == (int) S52_MP_get(S52_MAR_DISP_LEGEND))
             _drawLegend();
+        FRAME_STAT(draw);
 
         ret = S52_GL_end(S52_GL_DRAW);
+        FRAME_STAT(end);
 
         // for each cell, not after all cell,
         // because city name appear twice
@@ -3774,6 +4928,13 @@ exit:
     EGL_END(DRAW);
 #endif
 
+#ifdef S52_USE_FRAME_STATS
+    if (TRUE == ret) {
+        FRAME_STAT(swap);
+        _frameStatEnd(S52_GL_DRAW);
+    }
+#endif
+
 #ifdef S52_DEBUG
     {
         gdouble sec = g_timer_elapsed(_timer, NULL);
@@ -3926,6 +5087,11 @@ DLL int    STD S52_drawLast(void)
 
     S52_CHECK_INIT;
 
+#ifdef S52_USE_MAR_QUEUE
+    // Mariners' Object update queued since last frame
+    _pendApply();
+#endif
+
 #if !defined(S52_USE_RADAR)
     EGL_BEG(LAST);
 #endif
@@ -3937,6 +5103,9 @@ DLL int    STD S52_drawLast(void)
         goto exit;
 
     g_timer_reset(_timer);
+#ifdef S52_USE_FRAME_STATS
+    _frameStatBeg("last");
+#endif
 
 #ifdef S52_USE_BACKTRACE
     // debug
@@ -3968,8 +5137,10 @@ DLL int    STD S52_drawLast(void)
         for (S52ObjectType j=S52__META; j<S52_N_OBJ; ++j) {
             ret = ret && _drawLast(_marinerCell->renderBin[S52_PRIO_MARINR][j]);
         }
+        FRAME_STAT(last);
 
         S52_GL_end(S52_GL_LAST);
+        FRAME_STAT(end);
     } else {
         PRINTF("WARNING: S52_GL_begin() failed\n");
     }
@@ -3978,6 +5149,13 @@ exit:
 
     EGL_END(LAST);
 
+#ifdef S52_USE_FRAME_STATS
+    if (TRUE == ret) {
+        FRAME_STAT(swap);
+        _frameStatEnd(S52_GL_LAST);
+    }
+#endif
+
 #ifdef S52_DEBUG
     {
         //gdouble sec = g_timer_elapsed(_timer, NULL);
@@ -4069,6 +5247,16 @@ DLL int    STD S52_loadPLib(const char *plibName)
         // replace new rbin in cell
         TRAV_RBIN_ij(cell->renderBin[i][j] = tmpCell.renderBin[i][j]);
 
+#ifdef S52_USE_RTREE
+        _rtreeDone(cell);
+#endif
+
+#ifdef S52_USE_CS_MP_DEP
+        // new LUP - new CS
+        if (cell != _marinerCell)
+            _MPdepBuild(cell);
+#endif
+
         /* optimisation: recompute only CS that change due to new MarParam value
         // save reference for quickly find CS to re-compute after a MarinerParameter change
         // will replace the ugly APP() code that handle _doAPP_CS
@@ -4855,6 +6043,56 @@ exit:
     return name;
 }
 
+DLL CCHAR *STD S52_getFrameStats(unsigned int nFrame)
+{
+    static const char *str;
+    str = NULL;
+
+    S52_CHECK_MUTX_INIT;
+
+#ifdef S52_USE_FRAME_STATS
+    if (NULL == _frameStatsStr)
+        _frameStatsStr = g_string_new("");
+    g_string_set_size(_frameStatsStr, 0);
+
+    guint n = MIN(_frameNo, FRAME_STATS_HIST);
+    if (nFrame < n)
+        n = nFrame;
+
+    g_string_append_c(_frameStatsStr, '[');
+    for (guint i=0; i<n; ++i) {
+        // oldest first
+        _frameStat *f = &_frameStats[(_frameNo - n + i) % FRAME_STATS_HIST];
+
+        g_string_append_printf(_frameStatsStr, "%s{\"frame\":%u,\"cycle\":\"%s\",", (0==i) ? "" : ",", f->frame, f->cycle);
+        g_string_append_printf(_frameStatsStr, "\"msec\":{\"app\":%.3f,\"cull\":%.3f,\"draw\":%.3f,\"text\":%.3f,\"last\":%.3f,"
+                                               "\"end\":%.3f,\"swap\":%.3f,\"total\":%.3f,\"gpu\":%.3f},",
+                               f->app, f->cull, f->draw, f->text, f->last, f->end, f->swap, f->total, f->gl.gpuMsec);
+
+        g_string_append(_frameStatsStr, "\"layer\":[");
+        for (int l=0; l<S52_PRIO_NUM; ++l)
+            g_string_append_printf(_frameStatsStr, "%s%.3f", (0==l) ? "" : ",", f->layer[l]);
+
+        g_string_append_printf(_frameStatsStr, "],\"count\":{\"tested\":%u,\"culled\":%u,\"obj\":%u,\"cmd\":%u,\"clip\":%u,"
+                                               "\"drawCall\":%u,\"vertex\":%u,\"tris\":%u,\"triStrip\":%u,\"triFan\":%u,\"frag\":%u}}",
+                               f->nTotal, f->nCull, f->gl.nobj, f->gl.ncmd, f->gl.oclip, f->gl.nDrawCall, f->gl.nVertex,
+                               f->gl.nTris, f->gl.nTriStrip, f->gl.nTriFan, f->gl.nFrag);
+    }
+    g_string_append_c(_frameStatsStr, ']');
+
+    str = _frameStatsStr->str;
+#else
+    (void)nFrame;
+    PRINTF("WARNING: need -DS52_USE_FRAME_STATS\n");
+#endif
+
+exit:
+
+    GMUTEXUNLOCK(&_mp_mutex);
+
+    return str;
+}
+
 DLL CCHAR *STD S52_getPLibNameList(void)
 {
     static const char *str;
@@ -5222,7 +6460,7 @@ DLL int    STD S52_dumpS57IDPixels(const char *toFilename, unsigned int S57ID, u
         goto exit;
 
     if (0 == S57ID) {
-        S52_GL_dumpS57IDPixels(toFilename, NULL, width, height);
+        ret = S52_GL_dumpS57IDPixels(toFilename, NULL, width, height);
     } else {
         S52_obj *obj = S52_PL_isObjValid(S57ID);
         if (NULL != obj)
@@ -5498,6 +6736,9 @@ static S52ObjectHandle     _newMarObj(const char *plibObjName, S52ObjectType obj
 
     S57_setName(geo, plibObjName);
 
+    // coord can be edited in place (S52_pushPosition(), S52_setVRMEBL(), ..) - no GPU copy
+    S57_setGeoDyn(geo, TRUE);
+
     // full of coordinate
     if (NULL != xyz) {
         if (0 == xyznbr) {
@@ -5819,6 +7060,11 @@ DLL S52ObjectHandle STD S52_newLEGLIN(int select, double plnspd, double wholinDi
 
             _app();
 
+#ifdef S52_USE_THREAD_PRJ
+            // cells along the leg
+            _projectCellsInView(ext);
+#endif
+
             // cull
             // all cells - larger region first (small scale)
             for (guint i=_cellList->len-1; i>0; --i) {
@@ -6124,17 +7370,15 @@ exit:
     return objH;
 }
 
-DLL S52ObjectHandle STD S52_setVector(S52ObjectHandle objH, int vecstb, double course, double speed)
+static S52ObjectHandle _setVector(S52ObjectHandle objH, int vecstb, double course, double speed)
+// Note: _mp_mutex held by caller
 {
-    S52_CHECK_MUTX_INIT;
-
     // debug
     PRINTF("objH:%u, vecstb:%i, course:%f, speed:%f\n", objH, vecstb, course, speed);
 
     S52_obj *obj = S52_PL_isObjValid(objH);
     if (NULL == obj) {
-        objH = FALSE;
-        goto exit;
+        return FALSE;
     }
 
     // debug
@@ -6165,6 +7409,19 @@ DLL S52ObjectHandle STD S52_setVector(S52ObjectHandle objH, int vecstb, double c
         objH = FALSE;
     }
 
+    return objH;
+}
+
+DLL S52ObjectHandle STD S52_setVector(S52ObjectHandle objH, int vecstb, double course, double speed)
+{
+#ifdef S52_USE_MAR_QUEUE
+    return _pendAdd(_PEND_VEC, objH, course, speed, 0.0, vecstb, 0, 0, NULL);
+#endif
+
+    S52_CHECK_MUTX_INIT;
+
+    objH = _setVector(objH, vecstb, course, speed);
+
 exit:
 
     GMUTEXUNLOCK(&_mp_mutex);
@@ -6258,15 +7515,13 @@ static S52_obj            *_setPointPosition(S52_obj *obj, double latitude, doub
     return obj;
 }
 
-DLL S52ObjectHandle STD S52_pushPosition(S52ObjectHandle objH, double latitude, double longitude, double data)
+static S52ObjectHandle _pushPosition(S52ObjectHandle objH, double latitude, double longitude, double data)
 // FIXME: if ownshp check alarm - call _GuardZoneCheck()
+// Note: _mp_mutex held by caller
 {
-    S52_CHECK_MUTX_INIT;
-
     S52_obj *obj = S52_PL_isObjValid(objH);
     if (NULL == obj) {
-        objH = FALSE;
-        goto exit;
+        return FALSE;
     }
 
     // debug
@@ -6276,8 +7531,7 @@ DLL S52ObjectHandle STD S52_pushPosition(S52ObjectHandle objH, double latitude,
     _mutexOwner = "S52_pushPosition";
 
     if (NULL == S57_getPrjStr()) {
-        objH = FALSE;
-        goto exit;
+        return FALSE;
     }
 
     // clutter
@@ -6312,8 +7566,7 @@ DLL S52ObjectHandle STD S52_pushPosition(S52ObjectHandle objH, double latitude,
         pt3 p = {longitude, latitude, 0.0};
         if (FALSE == S57_geo2prj3dv(1, &p)) {
             PRINTF("WARNING: S57_geo2prj3dv() fail\n");
-            objH = FALSE;
-            goto exit;
+            return FALSE;
         }
 
         if (sz < npt) {
@@ -6355,6 +7608,19 @@ DLL S52ObjectHandle STD S52_pushPosition(S52ObjectHandle objH, double latitude,
 
     }
 
+    return objH;
+}
+
+DLL S52ObjectHandle STD S52_pushPosition(S52ObjectHandle objH, double latitude, double longitude, double data)
+{
+#ifdef S52_USE_MAR_QUEUE
+    return _pendAdd(_PEND_POS, objH, latitude, longitude, data, 0, 0, 0, NULL);
+#endif
+
+    S52_CHECK_MUTX_INIT;
+
+    objH = _pushPosition(objH, latitude, longitude, data);
+
 exit:
 
     GMUTEXUNLOCK(&_mp_mutex);
@@ -6413,17 +7679,15 @@ exit:
     return vessel;
 }
 
-DLL S52ObjectHandle STD S52_setVESSELlabel(S52ObjectHandle objH, const char *newLabel)
+static S52ObjectHandle _setVESSELlabel(S52ObjectHandle objH, const char *newLabel)
+// Note: _mp_mutex held by caller
 {
-    S52_CHECK_MUTX_INIT;
-
     // debug
     _mutexOwner = "S52_setLabel";
 
     S52_obj *obj = S52_PL_isObjValid(objH);
     if (NULL == obj) {
-        objH = FALSE;
-        goto exit;
+        return FALSE;
     }
     // debug
     _mutexOwnerS57ID = S57_getS57ID(S52_PL_getGeo(obj));
@@ -6441,9 +7705,21 @@ DLL S52ObjectHandle STD S52_setVESSELlabel(S52ObjectHandle objH, const char *new
     } else {
         PRINTF("WARNING: not a 'ownshp' or 'vessel' object\n");
         objH = FALSE;
-        goto exit;
     }
 
+    return objH;
+}
+
+DLL S52ObjectHandle STD S52_setVESSELlabel(S52ObjectHandle objH, const char *newLabel)
+{
+#ifdef S52_USE_MAR_QUEUE
+    return _pendAdd(_PEND_LABEL, objH, 0.0, 0.0, 0.0, 0, 0, 0, newLabel);
+#endif
+
+    S52_CHECK_MUTX_INIT;
+
+    objH = _setVESSELlabel(objH, newLabel);
+
 exit:
 
     GMUTEXUNLOCK(&_mp_mutex);
@@ -6456,17 +7732,15 @@ exit:
 
 }
 
-DLL S52ObjectHandle STD S52_setVESSELstate(S52ObjectHandle objH, int vesselSelect, int vestat, int vesselTurn)
+static S52ObjectHandle _setVESSELstate(S52ObjectHandle objH, int vesselSelect, int vestat, int vesselTurn)
+// Note: _mp_mutex held by caller
 {
-    S52_CHECK_MUTX_INIT;
-
     // debug
     PRINTF("objH:%u, vesselSelect:%i, vestat:%i, vesselTurn:%i\n", objH, vesselSelect, vestat, vesselTurn);
 
     S52_obj *obj = S52_PL_isObjValid(objH);
     if (NULL == obj) {
-        objH = FALSE;
-        goto exit;
+        return FALSE;
     }
 
     if (TRUE==_isMarObjValid(obj, "ownshp") || TRUE==_isMarObjValid(obj, "vessel") ||
@@ -6539,6 +7813,19 @@ DLL S52ObjectHandle STD S52_setVESSELstate(S52ObjectHandle objH, int vesselSelec
         objH = FALSE;
     }
 
+    return objH;
+}
+
+DLL S52ObjectHandle STD S52_setVESSELstate(S52ObjectHandle objH, int vesselSelect, int vestat, int vesselTurn)
+{
+#ifdef S52_USE_MAR_QUEUE
+    return _pendAdd(_PEND_STATE, objH, 0.0, 0.0, 0.0, vesselSelect, vestat, vesselTurn, NULL);
+#endif
+
+    S52_CHECK_MUTX_INIT;
+
+    objH = _setVESSELstate(objH, vesselSelect, vestat, vesselTurn);
+
 exit:
 
     GMUTEXUNLOCK(&_mp_mutex);
@@ -6553,6 +7840,169 @@ exit:
     return objH;
 }
 
+DLL int    STD S52_setVESSELbatch(unsigned int n, S52ObjectHandle *objH, double *latitude, double *longitude,
+                                  double *course, double *speed, double *heading, int *vestat)
+{
+    int nUpd = 0;
+
+    S52_CHECK_MUTX_INIT;
+
+    // debug
+    _mutexOwner = "S52_setVESSELbatch";
+
+    if ((NULL==objH) || (NULL==latitude) || (NULL==longitude) || (NULL==course) ||
+        (NULL==speed) || (NULL==heading) || (NULL==vestat)) {
+        PRINTF("WARNING: NULL array\n");
+        goto exit;
+    }
+
+    if (NULL == S57_getPrjStr())
+        goto exit;
+
+#ifdef S52_USE_MAR_QUEUE
+    // keep update order - single update queued before this call first
+    _pendApply();
+#endif
+
+    for (guint i=0; i<n; ++i) {
+        S52_obj *obj = S52_PL_isObjValid(objH[i]);
+        if (NULL == obj)
+            continue;
+
+        if (FALSE == _isMarObjValid(obj, "vessel")) {
+            PRINTF("WARNING: not a 'vessel' object (%u)\n", objH[i]);
+            continue;
+        }
+
+        S57_geo *geo = S52_PL_getGeo(obj);
+
+        // position - one extent update
+        pt3 pt = {_validate_lon(longitude[i]), _validate_lat(latitude[i]), 0.0};
+        _setMarExt(geo, 1, &pt);
+        if (FALSE == S57_geo2prj3dv(1, &pt)) {
+            PRINTF("WARNING: S57_geo2prj3dv() fail\n");
+            continue;
+        }
+        _updateGeo(obj, &pt);
+
+        // reset timer for AIS
+        S52_PL_setTimeNow(obj);
+        S52_PL_setSYorient(obj, heading[i]);
+
+        // heading, vector and state - one attribute pass
+        char attval[160] = {'\0'};
+        SNPRINTF(attval, 160, "headng:%f,cogcrs:%f,sogspd:%f,ctwcrs:%f,stwspd:%f",
+                 heading[i], course[i], speed[i], course[i], speed[i]);
+
+        // Note: skip vestat if 0 (undefined)
+        if (1==vestat[i] || 2==vestat[i] || 3==vestat[i]) {
+            int offset = strlen(attval);
+            SNPRINTF(attval+offset, 160-offset, ",vestat:%i", vestat[i]);
+
+            // red
+            S57_setHighlight(geo, (3 == vestat[i]) ? TRUE : FALSE);
+        }
+
+        _setMarAtt(geo, attval);
+
+        ++nUpd;
+    }
+
+exit:
+
+    GMUTEXUNLOCK(&_mp_mutex);
+
+    // debug
+    _mutexOwner = NULL;
+    _mutexOwnerS57ID = 0;
+
+    return nUpd;
+}
+
+#ifdef S52_USE_MAR_QUEUE
+static S52ObjectHandle _pendAdd(_pendType type, S52ObjectHandle objH, double d0, double d1, double d2,
+                                int i0, int i1, int i2, const char *str)
+// queue update - _mp_mutex not taken
+{
+    // Note: handle is validated when applied (_objHash is guarded by _mp_mutex)
+    if ((TRUE==_doInit) || (0==objH))
+        return FALSE;
+
+    _pendUpd upd = {type, objH, {d0, d1, d2}, {i0, i1, i2}, (NULL==str) ? NULL : g_strdup(str)};
+
+    GMUTEXLOCK(&_pend_mutex);
+    if (NULL == _pendQ[0]) {
+        _pendQ[0] = g_array_new(FALSE, FALSE, sizeof(_pendUpd));
+        _pendQ[1] = g_array_new(FALSE, FALSE, sizeof(_pendUpd));
+    }
+    g_array_append_val(_pendQ[_pendW], upd);
+    guint len = _pendQ[_pendW]->len;
+    GMUTEXUNLOCK(&_pend_mutex);
+
+    // no draw for a while - apply here rather than grow forever
+    if (PEND_MAX < len) {
+        GMUTEXLOCK(&_mp_mutex);
+        _pendApply();
+        GMUTEXUNLOCK(&_mp_mutex);
+    }
+
+    return objH;
+}
+
+static int        _pendApply(void)
+// apply queued update in order
+// Note: _mp_mutex held by caller
+{
+    GMUTEXLOCK(&_pend_mutex);
+    GArray *q = _pendQ[_pendW];
+    // callers now append to the other queue
+    _pendW = (0 == _pendW) ? 1 : 0;
+    GMUTEXUNLOCK(&_pend_mutex);
+
+    if (NULL == q)
+        return FALSE;
+
+    for (guint i=0; i<q->len; ++i) {
+        _pendUpd *upd = &g_array_index(q, _pendUpd, i);
+
+        switch (upd->type) {
+            case _PEND_POS:   _pushPosition  (upd->objH, upd->d[0], upd->d[1], upd->d[2]);  break;
+            case _PEND_VEC:   _setVector     (upd->objH, upd->i[0], upd->d[0], upd->d[1]);  break;
+            case _PEND_LABEL: _setVESSELlabel(upd->objH, upd->str);                         break;
+            case _PEND_STATE: _setVESSELstate(upd->objH, upd->i[0], upd->i[1], upd->i[2]);  break;
+        }
+
+        g_free(upd->str);
+    }
+    g_array_set_size(q, 0);
+
+    // debug
+    _mutexOwner      = NULL;
+    _mutexOwnerS57ID = 0;
+
+    return TRUE;
+}
+
+static int        _pendDone(void)
+// Note: _pend_mutex - a caller may still be queuing (_pendAdd() don't take _mp_mutex)
+{
+    GMUTEXLOCK(&_pend_mutex);
+    for (int k=0; k<2; ++k) {
+        if (NULL == _pendQ[k])
+            continue;
+
+        for (guint i=0; i<_pendQ[k]->len; ++i)
+            g_free(g_array_index(_pendQ[k], _pendUpd, i).str);
+        g_array_free(_pendQ[k], TRUE);
+        _pendQ[k] = NULL;
+    }
+    _pendW = 0;
+    GMUTEXUNLOCK(&_pend_mutex);
+
+    return TRUE;
+}
+#endif  // S52_USE_MAR_QUEUE
+
 DLL S52ObjectHandle STD S52_newVRMEBL(int vrm, int ebl, int normalLineStyle, int setOrigin)
 {
     S52ObjectHandle vrmebl = FALSE;
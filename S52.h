@@ -387,6 +387,28 @@ DLL int    STD S52_drawBlit(double scale_x, double scale_y, double scale_z, doub
  */
 DLL const char * STD S52_pickAt(double pixels_x, double pixels_y);
 
+/**
+ * S52_getFrameStats: Frame statistic
+ * @nFrame: (in): number of the most recent frame to return (rolling history of 128 frames)
+ *
+ * Per-stage time in msec and counters of each S52_draw() ("draw") and S52_drawLast() ("last"),
+ * oldest first, as a JSON array of:
+ * {"frame":n,"cycle":"draw","msec":{"app","cull","draw","text","last","end","swap","total","gpu"},
+ *  "layer":[msec of draw per display priority 0..9],
+ *  "count":{"tested","culled","obj","cmd","clip","drawCall","vertex","tris","triStrip","triFan","frag"}}
+ *
+ * "gpu" is from GL_EXT_disjoint_timer_query of a previous cycle, -1 if not available.
+ * "tris", "triStrip", "triFan" are the tessellated area primitives drawn (VBO), "frag" the
+ * number of fragment attribute (color) set.
+ * "swap" is the time spend in the EGL callback (eglSwapBuffers()).
+ *
+ * Note: need libS52 build with -DS52_USE_FRAME_STATS
+ *
+ *
+ * Return: (transfer none): JSON string, else NULL
+ */
+DLL const char * STD S52_getFrameStats(unsigned int nFrame);
+
 
 //----- NO GL context (can work outside main loop) ----------
 
@@ -484,6 +506,9 @@ int            S52_loadObject(const char *objname, /* OGRFeatureH */ void *featu
  * This callback provide a way to manipulate each S57 object before
  * they are inserted into the scenegraph (via S52_loadObject())
  *
+ * Note: with S52_USE_THREAD_LOAD the callback is called from worker threads,
+ *       one cell per thread and concurrently - it must be thread-safe
+ *
  *
  * Return: TRUE on success, else FALSE
  */
@@ -503,6 +528,8 @@ typedef int (*S52_loadObject_cb)(const char *objname, /* OGRFeatureH */ void *fe
  * Note: Interrupt 2 (ANSI) - user press Ctrl-C to stop long running process
  *       (if compiled with S52_USE_SUPP_LINE_OVERLAP and/or S52_USE_C_AGGR_C_ASSO,
  *        analysis can be expensive in large ENC)
+ * Note: with S52_USE_THREAD_LOAD the cells of a path are loaded in parallel and
+ *       @loadObject_cb (and the layer callback) run on worker threads - see S52_loadObject_cb
  *
  * Return: TRUE on success, else FALSE
  */
@@ -926,6 +953,7 @@ DLL S52ObjectHandle STD S52_setDimension(S52ObjectHandle objH, double a, double
  * @speed:  (in): (kt)
  *
  * Note: @vecstb apply to VESSEL only, use S52_MAR_VECSTB for OWNSHP
+ * Note: queued with S52_USE_MAR_QUEUE (see S52_pushPosition())
  *
  *
  * Return: @S52ObjectHandle of the adressed S52_obj or FALSE if call fail
@@ -960,6 +988,9 @@ DLL S52ObjectHandle STD S52_newPASTRK(int catpst, unsigned int xyznbrmax);
  *
  * Note: call will fail if no ENC loaded (via S52_loadCell)
  *
+ * Note: if compiled with S52_USE_MAR_QUEUE the update is queued, without waiting for a draw in progress,
+ * and applied at the start of the next S52_draw() / S52_drawLast(). Then @objH is validated at that time.
+ *
  *
  * Return: @S52ObjectHandle of the adressed S52_obj or FALSE if call fail
  */
@@ -985,6 +1016,7 @@ DLL S52ObjectHandle STD S52_newVESSEL(int vesrce, const char *label);
  *
  * (re) set label
  * Note: text priority of @newLabel is 76
+ * Note: queued with S52_USE_MAR_QUEUE (see S52_pushPosition())
  *
  *
  * Return: @S52ObjectHandle of the adressed S52_obj or FALSE if call fail
@@ -1008,12 +1040,38 @@ DLL S52ObjectHandle STD S52_setVESSELlabel(S52ObjectHandle objH, const char *new
  * "undefined" mean that the current value of the variable of this objH is unafected
  *
  * Note: experimental @vestat = 3 - AIS active, close quarter (red)
+ * Note: queued with S52_USE_MAR_QUEUE (see S52_pushPosition())
  *
  *
  * Return: @S52ObjectHandle of the adressed S52_obj or FALSE if call fail
  */
 DLL S52ObjectHandle STD S52_setVESSELstate(S52ObjectHandle objH, int vesselSelect, int vestat, int vesselTurn);
 
+/**
+ * S52_setVESSELbatch: VESSEL
+ * @n:         (in): number of target in each array
+ * @objH:      (in) (array length=n): addressed S52ObjectHandle
+ * @latitude:  (in) (array length=n):
+ * @longitude: (in) (array length=n):
+ * @course:    (in) (array length=n): (deg)
+ * @speed:     (in) (array length=n): (kt)
+ * @heading:   (in) (array length=n): (deg)
+ * @vestat:    (in) (array length=n): 0 - undefined, 1 - AIS active, 2 - AIS sleeping, 3 - AIS active, close quarter (red)
+ *
+ * Update many AIS targets in one call: same as S52_pushPosition(), S52_setVector() (@vecstb unafected)
+ * and S52_setVESSELstate() (@vestat only) on each target, under one lock with one extent update per target.
+ * Invalid @objH and object other than 'vessel' are skipped.
+ *
+ * Note: call will fail if no ENC loaded (via S52_loadCell)
+ * Note: over the socket (S52_USE_SOCK) one JSON message is capped at 2047 byte (SOCK_BUF),
+ *       about 25 target - send a bigger batch in many call
+ *
+ *
+ * Return: number of target updated
+ */
+DLL int             STD S52_setVESSELbatch(unsigned int n, S52ObjectHandle *objH, double *latitude, double *longitude,
+                                           double *course, double *speed, double *heading, int *vestat);
+
 
 // --- VRM & EBL -------------------
 
@@ -34,6 +34,10 @@
 
 #define UNKNOWN_DEPTH -1000.0  // depth of 1km above sea level
 
+#if defined(S52_USE_CS_TOUCH_IDX) && !defined(S52_USE_RTREE)
+#error "CS touch index need S57_rtree (S52_USE_RTREE)"
+#endif
+
 // loadCell() - keep ref on S57_geo for further proccessing in CS
 typedef struct _localObj {
     GPtrArray *lights_list;  // list of: LIGHTS
@@ -41,6 +45,16 @@ typedef struct _localObj {
     GPtrArray *depcnt_list;  // list of: DEPARE:A, DRGARE:A used by CS(DEPCNT02)
     GPtrArray *udwhaz_list;  // list of: DEPARE:A/L and DRGARE:A used by CS(_UDWHAZ03)
     GPtrArray *depval_list;  // list of geo used by CS(_DEPVAL01) (via OBSTRN04, WRECKS02)
+
+#ifdef S52_USE_CS_TOUCH_IDX
+    // S52_CS_touch() - candidate at the same position (point) or extent overlapping (area)
+    GHashTable *lights_hash; // position --> GPtrArray of LIGHTS
+    GHashTable *topmar_hash; // position --> GPtrArray of LITFLT, LITVES, BOY???
+    S57_rtree  *depcnt_rtree;
+    S57_rtree  *udwhaz_rtree;
+    S57_rtree  *depval_rtree;
+    GArray     *touch_res;   // index in list of candidate found in rtree
+#endif
 } _localObj;
 
 // Note: seem useless S52 specs -- no effect !?
@@ -110,6 +124,195 @@ CCHAR    *S52_CS_version(void)
     return version;
 }
 
+#ifdef S52_USE_CS_MP_DEP
+gboolean  S52_CS_readMP(const char *CSname, S52MarinerParameter paramID)
+// Note: CS procedure family (6 char) - ie DEPARE02, DEPARE03 call DEPARE01
+{
+    const char *CSlist = NULL;
+
+    if (NULL == CSname)
+        return FALSE;
+
+    switch (paramID) {
+        // _SNDFRM02 (via OBSTRN04, WRECKS02, SOUNDG02) - DEPCNT02 depth label is commented out
+        case S52_MAR_SAFETY_DEPTH    : CSlist = "OBSTRN,WRECKS,SOUNDG";               break;
+        // _SEABED01
+        case S52_MAR_SHALLOW_CONTOUR :
+        case S52_MAR_DEEP_CONTOUR    :
+        case S52_MAR_TWO_SHADES      :
+        case S52_MAR_SHALLOW_PATTERN : CSlist = "DEPARE,SLCONS";                      break;
+        // _SEABED01, DEPCNT02, _UDWHAZ03
+        case S52_MAR_SAFETY_CONTOUR  : CSlist = "DEPARE,DEPCNT,OBSTRN,WRECKS,SLCONS"; break;
+        // DEPARE01, DEPCNT02, _DEPVAL01, _LITDSN01, SLCONS03, _UDWHAZ03
+        case S52_MAR_DATUM_OFFSET    : CSlist = "DEPARE,DEPCNT,OBSTRN,WRECKS,SLCONS,LIGHTS"; break;
+        // RESARE02
+        case S52_MAR_SYMBOLIZED_BND  : CSlist = "RESARE";                             break;
+
+        default: return FALSE;
+    }
+
+    for (; '\0'!=*CSlist; CSlist+=6) {
+        if (',' == *CSlist)
+            ++CSlist;
+        if (0 == strncmp(CSname, CSlist, 6))
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+#ifdef S52_DEBUG
+// debug - check the table of S52_CS_readMP() against the MP read by the CS at run time
+// Note: CS are expanded by the S52_USE_THREAD_APP / S52_USE_THREAD_LOAD workers - state per thread
+static S52_TLS const char *_CScrnt              = NULL;  // CS being expanded on this thread
+static S52_TLS gboolean    _CSwarn[S52_MAR_NUM] = {FALSE};
+
+GString  *S52_CS_checkMP(S52_CS_condSymb *CS, S57_geo *geo)
+// Note: mariner obj (lower case, ie "vessel") are not in the table - obj come and go
+{
+    CCHAR *name    = S57_getName(geo);
+    CCHAR *CSprev  = _CScrnt;
+
+    _CScrnt = ((NULL!=name) && (TRUE==g_ascii_islower(*name))) ? NULL : CS->name;
+    GString *CSinst = CS->CScb(geo);
+    _CScrnt = CSprev;
+
+    return CSinst;
+}
+#endif  // S52_DEBUG
+#endif  // S52_USE_CS_MP_DEP
+
+static double   _CS_MPget(S52MarinerParameter paramID)
+// Mariner Parameter read by a CS procedure
+{
+#if defined(S52_USE_CS_MP_DEP) && defined(S52_DEBUG)
+    if ((NULL!=_CScrnt) && (FALSE==S52_CS_readMP(_CScrnt, paramID)) && (FALSE==_CSwarn[paramID])) {
+        PRINTF("WARNING: CS %s read MP %i - not in S52_CS_readMP() table\n", _CScrnt, paramID);
+        _CSwarn[paramID] = TRUE;
+    }
+#endif
+
+    return S52_MP_get(paramID);
+}
+
+#ifdef S52_USE_CS_TOUCH_IDX
+static guint    _hashPos(gconstpointer key)
+{
+    const pt2 *pt = (const pt2 *)key;
+
+    return g_double_hash(&pt->x) ^ (g_double_hash(&pt->y) * 31);
+}
+
+static gboolean _equalPos(gconstpointer a, gconstpointer b)
+{
+    const pt2 *A = (const pt2 *)a;
+    const pt2 *B = (const pt2 *)b;
+
+    return (A->x==B->x && A->y==B->y) ? TRUE : FALSE;
+}
+
+static void     _freeBucket(gpointer bucket)
+{
+    g_ptr_array_free((GPtrArray *)bucket, TRUE);
+}
+
+static gboolean _getPos(S57_geo *geo, pt2 *pt)
+// TRUE if the extent of geo is a point
+{
+    ObjExt_t ext = S57_getGeoExt(geo);
+    if ((ext.W!=ext.E) || (ext.S!=ext.N) || (0==isfinite(ext.W)) || (0==isfinite(ext.S)))
+        return FALSE;
+
+    // Note: +0.0 - so that -0.0 and 0.0 hash the same
+    pt->x = ext.W + 0.0;
+    pt->y = ext.S + 0.0;
+
+    return TRUE;
+}
+
+static int      _addPos(GHashTable *hash, S57_geo *geo)
+// add geo to the bucket at its position
+// Note: S-57 LIGHTS, LITFLT, LITVES, BOY??? are point only
+{
+    pt2 pt;
+    if (FALSE == _getPos(geo, &pt)) {
+        PRINTF("WARNING: %s:%i not a point, not in position hash\n", S57_getName(geo), S57_getS57ID(geo));
+        return FALSE;
+    }
+
+    GPtrArray *bucket = (GPtrArray *)g_hash_table_lookup(hash, &pt);
+    if (NULL == bucket) {
+        pt2 *key = g_new(pt2, 1);
+        *key   = pt;
+        bucket = g_ptr_array_new();
+        g_hash_table_insert(hash, key, bucket);
+    }
+    // Note: order of insertion (S57ID) preserved in bucket
+    g_ptr_array_add(bucket, geo);
+
+    return TRUE;
+}
+#endif  // S52_USE_CS_TOUCH_IDX
+
+static GPtrArray *_touchAtPos(_localObj *local, GPtrArray *list, S57_geo *geo)
+// return the candidate of list (lights_list or topmar_list) at the same position as geo (NULL if none)
+{
+#ifdef S52_USE_CS_TOUCH_IDX
+    GHashTable *hash = (list == local->lights_list) ? local->lights_hash : local->topmar_hash;
+    pt2 pt;
+    if (TRUE == _getPos(geo, &pt))
+        return (GPtrArray *)g_hash_table_lookup(hash, &pt);
+#else
+    (void)local;
+    (void)geo;
+#endif
+
+    return list;
+}
+
+static guint    _touchInExt(_localObj *local, GPtrArray *list, S57_geo *geo)
+// return the number of candidate of list (depcnt_list, udwhaz_list or depval_list)
+// with an extent that overlap geo, see _touchGet()
+{
+#ifdef S52_USE_CS_TOUCH_IDX
+    S57_rtree **rtree = (list == local->depcnt_list) ? &local->depcnt_rtree :
+                        (list == local->udwhaz_list) ? &local->udwhaz_rtree :
+                                                       &local->depval_rtree ;
+
+    // list is complete when touch start (after all S52_CS_add())
+    if (S57_getRTreeSize(*rtree) != list->len) {
+        ObjExt_t *ext = g_new(ObjExt_t, list->len + 1);
+        for (guint i=0; i<list->len; ++i)
+            ext[i] = S57_getGeoExt((S57_geo *)g_ptr_array_index(list, i));
+
+        S57_doneRTree(*rtree);
+        *rtree = S57_newRTree(ext, list->len);
+        g_free(ext);
+    }
+
+    g_array_set_size(local->touch_res, 0);
+
+    return S57_queryRTree(*rtree, S57_getGeoExt(geo), local->touch_res);
+#else
+    (void)local;
+    (void)geo;
+
+    return list->len;
+#endif
+}
+
+static S57_geo *_touchGet(_localObj *local, GPtrArray *list, guint k)
+// return candidate k found by _touchInExt()
+{
+#ifdef S52_USE_CS_TOUCH_IDX
+    return (S57_geo *)g_ptr_array_index(list, g_array_index(local->touch_res, guint, k));
+#else
+    (void)local;
+
+    return (S57_geo *)g_ptr_array_index(list, k);
+#endif
+}
+
 localObj *S52_CS_init (void)
 {
     _localObj *local = g_new0(_localObj, 1);
@@ -123,6 +326,12 @@ localObj *S52_CS_init (void)
     local->udwhaz_list = g_ptr_array_new();
     local->depval_list = g_ptr_array_new();
 
+#ifdef S52_USE_CS_TOUCH_IDX
+    local->lights_hash = g_hash_table_new_full(_hashPos, _equalPos, g_free, _freeBucket);
+    local->topmar_hash = g_hash_table_new_full(_hashPos, _equalPos, g_free, _freeBucket);
+    local->touch_res   = g_array_new(FALSE, FALSE, sizeof(guint));
+#endif
+
     return local;
 }
 
@@ -143,6 +352,15 @@ localObj *S52_CS_done (_localObj *local)
     local->udwhaz_list = NULL;
     local->depval_list = NULL;
 
+#ifdef S52_USE_CS_TOUCH_IDX
+    g_hash_table_destroy(local->lights_hash);
+    g_hash_table_destroy(local->topmar_hash);
+    S57_doneRTree(local->depcnt_rtree);
+    S57_doneRTree(local->udwhaz_rtree);
+    S57_doneRTree(local->depval_rtree);
+    g_array_free(local->touch_res, TRUE);
+#endif
+
     g_free(local);
 
     return NULL;
@@ -165,6 +383,9 @@ int       S52_CS_add  (_localObj *local, S57_geo *geo)
         (0==strncmp  (name, "BOY", 3)))
     {
         g_ptr_array_add(local->topmar_list, (gpointer) geo);
+#ifdef S52_USE_CS_TOUCH_IDX
+        _addPos(local->topmar_hash, geo);
+#endif
         return TRUE;
     }
 
@@ -177,6 +398,9 @@ int       S52_CS_add  (_localObj *local, S57_geo *geo)
     if (0 == g_strcmp0(name, "LIGHTS")) {
         // Note: order of S57ID are preserved (ID1 < ID2 < ID3 ..)
         g_ptr_array_add(local->lights_list, (gpointer) geo);
+#ifdef S52_USE_CS_TOUCH_IDX
+        _addPos(local->lights_hash, geo);
+#endif
         return TRUE;
     }
 
@@ -226,8 +450,9 @@ int       S52_CS_touch(_localObj *local, S57_geo *geo)
     ////////////////////////////////////////////
     // floating object
     if (0 == g_strcmp0(name, "TOPMAR")) {
-        for (guint i=0; i<local->topmar_list->len; ++i) {
-            S57_geo *other = (S57_geo *) g_ptr_array_index(local->topmar_list, i);
+        GPtrArray *topmar_list = _touchAtPos(local, local->topmar_list, geo);
+        for (guint i=0; NULL!=topmar_list && i<topmar_list->len; ++i) {
+            S57_geo *other = (S57_geo *) g_ptr_array_index(topmar_list, i);
 
             // skip if not at same position
             if (FALSE == S57_cmpGeoExt(geo, other))
@@ -258,9 +483,10 @@ int       S52_CS_touch(_localObj *local, S57_geo *geo)
     // experimental:
     // check if this buoy has a lights
     if (0 == g_strcmp0(name, "BOYLAT")) {
-        for (guint i=0; i<local->lights_list->len; ++i) {
+        GPtrArray *lights_list = _touchAtPos(local, local->lights_list, geo);
+        for (guint i=0; NULL!=lights_list && i<lights_list->len; ++i) {
 
-            S57_geo *light = (S57_geo *) g_ptr_array_index(local->lights_list, i);
+            S57_geo *light = (S57_geo *) g_ptr_array_index(lights_list, i);
 
             // skip if this light is not at buoy's position
             if (FALSE == S57_cmpGeoExt(geo, light))
@@ -289,8 +515,9 @@ int       S52_CS_touch(_localObj *local, S57_geo *geo)
     // LIGHTS05:sector
     // chaine light at same position
     if (0 == g_strcmp0(name, "LIGHTS")) {
-        for (guint i=0; i<local->lights_list->len; ++i) {
-            S57_geo *candidate = (S57_geo *) g_ptr_array_index(local->lights_list, i);
+        GPtrArray *lights_list = _touchAtPos(local, local->lights_list, geo);
+        for (guint i=0; NULL!=lights_list && i<lights_list->len; ++i) {
+            S57_geo *candidate = (S57_geo *) g_ptr_array_index(lights_list, i);
 
             // skip if allready processed / same LIGHTS
             if (S57_getS57ID(candidate) <= S57_getS57ID(geo))
@@ -358,8 +585,9 @@ int       S52_CS_touch(_localObj *local, S57_geo *geo)
 
         // select the next deeper contour as the safety contour
         // when the contour requested is not in the ENC
-        for (guint i=0; i<local->depcnt_list->len; ++i) {
-            S57_geo *candidate = (S57_geo *) g_ptr_array_index(local->depcnt_list, i);
+        guint n = _touchInExt(local, local->depcnt_list, geo);
+        for (guint i=0; i<n; ++i) {
+            S57_geo *candidate = _touchGet(local, local->depcnt_list, i);
 
             // skip if it's same S57 object (DEPARE)
             if (S57_getS57ID(geo) == S57_getS57ID(candidate))
@@ -415,9 +643,10 @@ int       S52_CS_touch(_localObj *local, S57_geo *geo)
         // find the deepest group 1 under this geo
         //double depth_max = 0.0;
         double depth_max = UNKNOWN_DEPTH;
-        for (guint i=0; i<local->udwhaz_list->len; ++i) {
+        guint n = _touchInExt(local, local->udwhaz_list, geo);
+        for (guint i=0; i<n; ++i) {
             // list of DEPARE:L/A and DRGARE:A
-            S57_geo *candidate = (S57_geo *) g_ptr_array_index(local->udwhaz_list, i);
+            S57_geo *candidate = _touchGet(local, local->udwhaz_list, i);
 
             // skip if not overlapping
             if (FALSE == S57_cmpGeoExt(geo, candidate))
@@ -515,8 +744,9 @@ int       S52_CS_touch(_localObj *local, S57_geo *geo)
         //double least_depth = INFINITY;
         double least_depth = UNKNOWN_DEPTH;
 
-        for (guint i=0; i<local->depval_list->len; ++i) {
-            S57_geo *candidate = (S57_geo *) g_ptr_array_index(local->depval_list, i);
+        guint n = _touchInExt(local, local->depval_list, geo);
+        for (guint i=0; i<n; ++i) {
+            S57_geo *candidate = _touchGet(local, local->depval_list, i);
 
             // skip if extent not overlapping
             if (FALSE == S57_cmpGeoExt(geo, candidate))
@@ -766,8 +996,8 @@ static GString *DEPARE01 (S57_geo *geo)
     double   drval2    = (NULL == drval2str) ? drval1+0.01 : S52_atof(drval2str->str);
 
     // adjuste datum
-    drval1 += S52_MP_get(S52_MAR_DATUM_OFFSET);
-    drval2 += S52_MP_get(S52_MAR_DATUM_OFFSET);
+    drval1 += _CS_MPget(S52_MAR_DATUM_OFFSET);
+    drval2 += _CS_MPget(S52_MAR_DATUM_OFFSET);
 
     depare01 = _SEABED01(drval1, drval2);
 
@@ -849,9 +1079,9 @@ static gboolean _DEPCNT02_isSC(S57_geo *geo)
             double drval1touch = S52_atof(drval1touchstr->str);
 
             // adjuste datum
-            drval1touch += S52_MP_get(S52_MAR_DATUM_OFFSET);
+            drval1touch += _CS_MPget(S52_MAR_DATUM_OFFSET);
 
-            if (drval1touch < S52_MP_get(S52_MAR_SAFETY_CONTOUR)) {
+            if (drval1touch < _CS_MPget(S52_MAR_SAFETY_CONTOUR)) {
                 safety_contour = TRUE;
             }
         }
@@ -901,13 +1131,13 @@ static GString *DEPCNT02 (S57_geo *geo)
         double   drval2    = (NULL == drval2str) ? drval1 : S52_atof(drval2str->str);
 
         // adjuste datum
-        drval1 += S52_MP_get(S52_MAR_DATUM_OFFSET);
-        drval2 += S52_MP_get(S52_MAR_DATUM_OFFSET);
+        drval1 += _CS_MPget(S52_MAR_DATUM_OFFSET);
+        drval2 += _CS_MPget(S52_MAR_DATUM_OFFSET);
 
         // invariant: DRVAL1 <= SC <= DRVAL2 (top of S52 3.2 DEPCNT02 Nassi flow chart)
         // is this line on SC
-        if (drval1 <= S52_MP_get(S52_MAR_SAFETY_CONTOUR)) {
-            if (drval2 >= S52_MP_get(S52_MAR_SAFETY_CONTOUR)) {
+        if (drval1 <= _CS_MPget(S52_MAR_SAFETY_CONTOUR)) {
+            if (drval2 >= _CS_MPget(S52_MAR_SAFETY_CONTOUR)) {
                 safety_contour = TRUE;
             }
         } else {
@@ -922,12 +1152,12 @@ static GString *DEPCNT02 (S57_geo *geo)
         double   valdco    = (NULL == valdcostr) ? 0.0 : S52_atof(valdcostr->str);
 
         // adjuste datum
-        valdco += S52_MP_get(S52_MAR_DATUM_OFFSET);
+        valdco += _CS_MPget(S52_MAR_DATUM_OFFSET);
 
-       if (valdco == S52_MP_get(S52_MAR_SAFETY_CONTOUR)) {
+       if (valdco == _CS_MPget(S52_MAR_SAFETY_CONTOUR)) {
             safety_contour = TRUE;
         } else {
-            if (valdco > S52_MP_get(S52_MAR_SAFETY_CONTOUR)) {
+            if (valdco > _CS_MPget(S52_MAR_SAFETY_CONTOUR)) {
                 // collect area DEPARE & DRGARE that touche this line
                 // get next deeper line
                 safety_contour = _DEPCNT02_isSC(geo);
@@ -1034,7 +1264,7 @@ static double   _DEPVAL01(S57_geo *geo, double least_depth)
 
     if (UNKNOWN_DEPTH != least_depth) {
         // adjuste datum
-        least_depth += S52_MP_get(S52_MAR_DATUM_OFFSET);
+        least_depth += _CS_MPget(S52_MAR_DATUM_OFFSET);
     }
 
     return least_depth;
@@ -1099,7 +1329,7 @@ static GString *LEGLIN02 (S57_geo *geo)
 
     /* FIXME: move to GL
     // TX: distance tags
-    //if (0.0 < S52_MP_get(S52_MAR_DISTANCE_TAGS)) {
+    //if (0.0 < _CS_MPget(S52_MAR_DISTANCE_TAGS)) {
         g_string_append(leglin02, ";SY(PLNPOS02);TX(_disttags,3,1,2,'15112',0,0,CHBLK,51)");
     }
     */
@@ -1721,10 +1951,10 @@ static GString *_LITDSN01(S57_geo *geo)
     // HEIGHT, xxx.x
     gstr = S57_getAttVal(geo, "HEIGHT");
     if (NULL != gstr) {
-        if (0.0 != S52_MP_get(S52_MAR_DATUM_OFFSET)) {
+        if (0.0 != _CS_MPget(S52_MAR_DATUM_OFFSET)) {
             // adjuste datum
             double height = S52_atof(gstr->str);
-            height -= S52_MP_get(S52_MAR_DATUM_OFFSET);
+            height -= _CS_MPget(S52_MAR_DATUM_OFFSET);
 
             char str[8] = {0};
             g_snprintf(str, 8, "%.1fm ", height);
@@ -2228,14 +2458,14 @@ static GString *OWNSHP02 (S57_geo *geo)
         g_string_append(ownshp02, ";LS(SOLD,1,SHIPS)");
 
     // draw OWNSHP05 if length > 10 mm, else OWNSHP01 (circle)
-    //if (TRUE == S52_MP_get(S52_MAR_SHIPS_OUTLINE))
+    //if (TRUE == _CS_MPget(S52_MAR_SHIPS_OUTLINE))
         g_string_append(ownshp02, ";SY(OWNSHP05)");
 
     g_string_append(ownshp02, ";SY(OWNSHP01)");
 
 
     // course / speed vector on ground / water
-    //if (0.0 != S52_MP_get(S52_MAR_VECPER))  {
+    //if (0.0 != _CS_MPget(S52_MAR_VECPER))  {
         // draw line according to ships course (cogcrs or ctwcrs) and speed (sogspd or stwspd)
         // Note: second LS() 2px
         //g_string_append(ownshp02, ";LS(SOLD,2,SHIPS)");
@@ -2243,33 +2473,33 @@ static GString *OWNSHP02 (S57_geo *geo)
 
         /*
         // vector stabilisation (symb place at the end of vector)
-        //if (0.0 != S52_MP_get(S52_MAR_VECSTB)) {
+        //if (0.0 != _CS_MPget(S52_MAR_VECSTB)) {
             // ground
-            //if (1.0 == S52_MP_get(S52_MAR_VECSTB))
+            //if (1.0 == _CS_MPget(S52_MAR_VECSTB))
                 g_string_append(ownshp02, ";SY(VECGND01)");
 
             // water
-            //if (2.0 == S52_MP_get(S52_MAR_VECSTB))
+            //if (2.0 == _CS_MPget(S52_MAR_VECSTB))
                 g_string_append(ownshp02, ";SY(VECWTR01)");
         }
         */
 
         // FIXME: move to GL
         // time mark (on vector)
-        //if (0.0 != S52_MP_get(S52_MAR_VECMRK)) {
+        //if (0.0 != _CS_MPget(S52_MAR_VECMRK)) {
             // 6 min. and 1 min. symb.
-            //if (1.0 == S52_MP_get(S52_MAR_VECMRK))
+            //if (1.0 == _CS_MPget(S52_MAR_VECMRK))
                 g_string_append(ownshp02, ";SY(OSPSIX02);SY(OSPONE02)");
 
             // 6 min. symb
-            //if (2.0 == S52_MP_get(S52_MAR_VECMRK))
+            //if (2.0 == _CS_MPget(S52_MAR_VECMRK))
             //    g_string_append(ownshp02, ";SY(OSPSIX02)");
         //}
     //}
 
     // beam bearing
     // Note: third LS() 1px
-    //if (0.0 != S52_MP_get(S52_MAR_BEAM_BRG_NM)) {
+    //if (0.0 != _CS_MPget(S52_MAR_BEAM_BRG_NM)) {
         g_string_append(ownshp02, ";LS(SOLD,1,SHIPS)");
     //}
 
@@ -2473,9 +2703,9 @@ static GString *SLCONS03 (S57_geo *geo)
 
         // adjuste datum
         if (UNKNOWN_DEPTH != drval1)
-            drval1 += S52_MP_get(S52_MAR_DATUM_OFFSET);
+            drval1 += _CS_MPget(S52_MAR_DATUM_OFFSET);
         if (UNKNOWN_DEPTH != drval2)
-            drval2 += S52_MP_get(S52_MAR_DATUM_OFFSET);
+            drval2 += _CS_MPget(S52_MAR_DATUM_OFFSET);
 
         // debug
         //PRINTF("***********drval1=%f drval2=%f \n", drval1, drval2);
@@ -2550,7 +2780,7 @@ static GString *RESARE02 (S57_geo *geo)
                 }
             }
 
-            if (TRUE == (int) S52_MP_get(S52_MAR_SYMBOLIZED_BND))
+            if (TRUE == (int) _CS_MPget(S52_MAR_SYMBOLIZED_BND))
                 line = ";LC(CTYARE51)";
             else
                 line = ";LS(DASH,2,CHMGD)";
@@ -2578,7 +2808,7 @@ static GString *RESARE02 (S57_geo *geo)
                     }
                 }
 
-                if (TRUE == (int) S52_MP_get(S52_MAR_SYMBOLIZED_BND))
+                if (TRUE == (int) _CS_MPget(S52_MAR_SYMBOLIZED_BND))
                     line = ";LC(ACHRES51)";
                 else
                     line = ";LS(DASH,2,CHMGD)";
@@ -2601,7 +2831,7 @@ static GString *RESARE02 (S57_geo *geo)
                         }
                     }
 
-                    if (TRUE == (int) S52_MP_get(S52_MAR_SYMBOLIZED_BND))
+                    if (TRUE == (int) _CS_MPget(S52_MAR_SYMBOLIZED_BND))
                         line = ";LC(FSHRES51)";
                     else
                         line = ";LS(DASH,2,CHMGD)";
@@ -2614,7 +2844,7 @@ static GString *RESARE02 (S57_geo *geo)
                     else
                         symb = ";SY(RSRDEF51)";
 
-                    if (TRUE == (int) S52_MP_get(S52_MAR_SYMBOLIZED_BND))
+                    if (TRUE == (int) _CS_MPget(S52_MAR_SYMBOLIZED_BND))
                         line = ";LC(CTYARE51)";
                     else
                         line = ";LS(DASH,2,CHMGD)";
@@ -2640,7 +2870,7 @@ static GString *RESARE02 (S57_geo *geo)
         } else
             symb = ";SY(RSRDEF51)";
 
-        if (TRUE == (int) S52_MP_get(S52_MAR_SYMBOLIZED_BND))
+        if (TRUE == (int) _CS_MPget(S52_MAR_SYMBOLIZED_BND))
             line = ";LC(CTYARE51)";
         else
             line = ";LS(DASH,2,CHMGD)";
@@ -2776,25 +3006,25 @@ static GString *_SEABED01(double drval1, double drval2)
     if (drval1 >= 0.0 && drval2 > 0.0)
         arecol  = ";AC(DEPVS)";
 
-    if (TRUE == (int) S52_MP_get(S52_MAR_TWO_SHADES)){
-        if (drval1 >= S52_MP_get(S52_MAR_SAFETY_CONTOUR)  &&
-            drval2 >  S52_MP_get(S52_MAR_SAFETY_CONTOUR)) {
+    if (TRUE == (int) _CS_MPget(S52_MAR_TWO_SHADES)){
+        if (drval1 >= _CS_MPget(S52_MAR_SAFETY_CONTOUR)  &&
+            drval2 >  _CS_MPget(S52_MAR_SAFETY_CONTOUR)) {
             arecol  = ";AC(DEPDW)";
             shallow = FALSE;
         }
     } else {
-        if (drval1 >= S52_MP_get(S52_MAR_SHALLOW_CONTOUR) &&
-            drval2 >  S52_MP_get(S52_MAR_SHALLOW_CONTOUR))
+        if (drval1 >= _CS_MPget(S52_MAR_SHALLOW_CONTOUR) &&
+            drval2 >  _CS_MPget(S52_MAR_SHALLOW_CONTOUR))
             arecol  = ";AC(DEPMS)";
 
-            if (drval1 >= S52_MP_get(S52_MAR_SAFETY_CONTOUR)  &&
-                drval2 >  S52_MP_get(S52_MAR_SAFETY_CONTOUR)) {
+            if (drval1 >= _CS_MPget(S52_MAR_SAFETY_CONTOUR)  &&
+                drval2 >  _CS_MPget(S52_MAR_SAFETY_CONTOUR)) {
                 arecol  = ";AC(DEPMD)";
                 shallow = FALSE;
             }
 
-            if (drval1 >= S52_MP_get(S52_MAR_DEEP_CONTOUR)  &&
-                drval2 >  S52_MP_get(S52_MAR_DEEP_CONTOUR)) {
+            if (drval1 >= _CS_MPget(S52_MAR_DEEP_CONTOUR)  &&
+                drval2 >  _CS_MPget(S52_MAR_DEEP_CONTOUR)) {
                 arecol  = ";AC(DEPDW)";
                 shallow = FALSE;
             }
@@ -2803,7 +3033,7 @@ static GString *_SEABED01(double drval1, double drval2)
 
     seabed01 = _g_string_new(seabed01, arecol);
 
-    if (TRUE==(int) S52_MP_get(S52_MAR_SHALLOW_PATTERN) && TRUE==shallow)
+    if (TRUE==(int) _CS_MPget(S52_MAR_SHALLOW_PATTERN) && TRUE==shallow)
         g_string_append(seabed01, ";AP(DIAMOND1)");
 
     return seabed01;
@@ -2870,7 +3100,7 @@ static GString *_SNDFRM02(S57_geo *geo, double depth_value)
     leading_digit = (int) depth_value;
     //leading_digit = floor(depth_value);
 
-    if (depth_value <= S52_MP_get(S52_MAR_SAFETY_DEPTH))
+    if (depth_value <= _CS_MPget(S52_MAR_SAFETY_DEPTH))
         symbol_prefix = "SOUNDS";
     else
         symbol_prefix = "SOUNDG";
@@ -3141,7 +3371,7 @@ static GString *_UDWHAZ03(S57_geo *geo, double depth_value)
     // first reset trigger scamin
     S57_setScamin(geo, S57_RESET_SCAMIN);
 
-    if (depth_value <= S52_MP_get(S52_MAR_SAFETY_CONTOUR)) {
+    if (depth_value <= _CS_MPget(S52_MAR_SAFETY_CONTOUR)) {
         S57_geo *geoTouch = S57_getTouchUDWHAZ(geo);
         if (NULL == geoTouch) {
             PRINTF("DEBUG: NULL geo _UDWHAZ03/getTouchDEPARE - case where depth_value < S52_MAR_SAFETY_CONTOUR\n");
@@ -3163,9 +3393,9 @@ static GString *_UDWHAZ03(S57_geo *geo, double depth_value)
             double drval2 = S52_atof(drval2str->str);
 
             // adjuste datum
-            drval2 += S52_MP_get(S52_MAR_DATUM_OFFSET);
+            drval2 += _CS_MPget(S52_MAR_DATUM_OFFSET);
 
-            if (drval2 > S52_MP_get(S52_MAR_SAFETY_CONTOUR)) {
+            if (drval2 > _CS_MPget(S52_MAR_SAFETY_CONTOUR)) {
                 danger = TRUE;
             }
 
@@ -3178,9 +3408,9 @@ static GString *_UDWHAZ03(S57_geo *geo, double depth_value)
             double drval1 = S52_atof(drval1str->str);
 
             // adjuste datum
-            drval1 += S52_MP_get(S52_MAR_DATUM_OFFSET);
+            drval1 += _CS_MPget(S52_MAR_DATUM_OFFSET);
 
-            if (drval1 >= S52_MP_get(S52_MAR_SAFETY_CONTOUR)) {
+            if (drval1 >= _CS_MPget(S52_MAR_SAFETY_CONTOUR)) {
                 danger = TRUE;
             }
         }
@@ -3281,7 +3511,7 @@ static GString *VESSEL01 (S57_geo *geo)
     g_string_append(vessel01, ";SY(VECGND21);SY(VECWTR21);LS(SOLD,2,ARPAT)");
 
     // experimental: AIS draw ship's silhouettte (OWNSHP05) if length > 10 mm
-    //if (TRUE == S52_MP_get(S52_MAR_SHIPS_OUTLINE) && (NULL!=vesrcestr && '2'==*vesrcestr->str))
+    //if (TRUE == _CS_MPget(S52_MAR_SHIPS_OUTLINE) && (NULL!=vesrcestr && '2'==*vesrcestr->str))
         g_string_append(vessel01, ";SY(OWNSHP05)");
 
     // ARPA
@@ -3297,13 +3527,13 @@ static GString *VESSEL01 (S57_geo *geo)
 
         // FIXME: move this to GL
         // add time mark (on ARPA vector)
-        //if (0.0 != S52_MP_get(S52_MAR_VECMRK)) {
+        //if (0.0 != _CS_MPget(S52_MAR_VECMRK)) {
             // 6 min. and 1 min. symb.
-            //if (1.0 == S52_MP_get(S52_MAR_VECMRK))
+            //if (1.0 == _CS_MPget(S52_MAR_VECMRK))
                 g_string_append(vessel01, ";SY(ARPSIX01);SY(ARPONE01)");
 
             // 6 min. symb
-            //if (2.0 == S52_MP_get(S52_MAR_VECMRK))
+            //if (2.0 == _CS_MPget(S52_MAR_VECMRK))
             //    g_string_append(vessel01, ";SY(ARPSIX01)");
         //}
     }
@@ -3339,20 +3569,20 @@ static GString *VESSEL01 (S57_geo *geo)
 #endif
 
         // add heading line (50 mm)
-        //if (TRUE == S52_MP_get(S52_MAR_HEADNG_LINE)) {
+        //if (TRUE == _CS_MPget(S52_MAR_HEADNG_LINE)) {
             g_string_append(vessel01, ";LS(SOLD,1,ARPAT)");
         //}
 
         // FIXME: move this to GL
         // add time mark (on AIS vector)
-        //if (0.0 != S52_MP_get(S52_MAR_VECMRK)) {
+        //if (0.0 != _CS_MPget(S52_MAR_VECMRK)) {
 
             // 6 min. and 1 min. symb
-            //if (1.0 == S52_MP_get(S52_MAR_VECMRK))
+            //if (1.0 == _CS_MPget(S52_MAR_VECMRK))
                 g_string_append(vessel01, ";SY(AISSIX01);SY(AISONE01)");
 
             // 6 min. symb only
-            //if (2.0 == S52_MP_get(S52_MAR_VECMRK))
+            //if (2.0 == _CS_MPget(S52_MAR_VECMRK))
             //    g_string_append(vessel01, ";SY(AISSIX01)");
         //}
     }
@@ -27,6 +27,7 @@
 
 
 #include "S57data.h"       // S57_geo
+#include "S52.h"           // S52MarinerParameter
 
 #include <glib.h>          // GString
 
@@ -52,4 +53,13 @@ localObj   *S52_CS_done (localObj *local);
 int         S52_CS_add  (localObj *local, S57_geo *geo);
 int         S52_CS_touch(localObj *local, S57_geo *geo);
 
+#ifdef S52_USE_CS_MP_DEP
+// TRUE if CS procedure CSname (or its sub-procedure) read Mariner Parameter paramID
+gboolean    S52_CS_readMP(const char *CSname, S52MarinerParameter paramID);
+#ifdef S52_DEBUG
+// expand CS - warn if it read a MP not in S52_CS_readMP()
+GString    *S52_CS_checkMP(S52_CS_condSymb *CS, S57_geo *geo);
+#endif
+#endif
+
 #endif //_S52CS_H_
@@ -32,6 +32,7 @@
 
 #include <glib.h>
 #include <glib/gstdio.h>  // g_file_test(),
+#include <string.h>       // memcpy()
 
 // compiled with -std=gnu99 (or -std=c99 -D_POSIX_C_SOURCE=???) will define M_PI
 #include <math.h>         // sin(), cos(), atan2(), pow(), sqrt(), floor(), fabs(), INFINITY, M_PI
@@ -46,6 +47,9 @@
 // state
 static int          _doInit        = TRUE;    // initialize (but GL context --need main loop)
 static GPtrArray   *_objPick       = NULL;    // list of object picked
+#ifdef S52_USE_PICK_GEO
+static GArray      *_objPickCol    = NULL;    // color index of _objPick obj rendered on GPU, 0 if picked by geometry
+#endif
 static GString     *_strPick       = NULL;    // hold temps val
 //static int          _doHighlight   = FALSE;   // TRUE then _objhighlight point to the object to hightlight
 static S52_GL_cycle _crnt_GL_cycle = S52_GL_INIT; // state before first S52_GL_DRAW
@@ -173,6 +177,21 @@ static double _dotpitch_mm_y = 0.3;  // will be overwright at init()
 #if defined(S52_USE_GLSC2) && !defined(S52_USE_EGL)
 #error "GLSC2 need EGL"
 #endif
+#if defined(S52_USE_AC_BATCH) && (!defined(S52_USE_GL2) || defined(S52_USE_GLSC2))
+#error "AC batch need GL2 (VBO delete)"
+#endif
+#if defined(S52_USE_SY_INST) && (!defined(S52_USE_GL2) || defined(S52_USE_GLSC2))
+#error "SY instancing need GL2"
+#endif
+#if defined(S52_USE_TXT_BATCH) && !defined(S52_USE_FREETYPE_GL)
+#error "text batch need Freetype GL"
+#endif
+#if defined(S52_USE_AP_CACHE) && !defined(S52_USE_GL2)
+#error "AP() texture cache need GL2"
+#endif
+#if defined(S52_USE_TXT_SDF) && (!defined(S52_USE_FREETYPE_GL) || defined(S52_USE_GLSC2))
+#error "SDF text need Freetype GL (GL_ALPHA atlas)"
+#endif
 
 // GL1.x
 #ifdef S52_USE_GL1
@@ -199,7 +218,7 @@ static double _dotpitch_mm_y = 0.3;  // will be overwright at init()
 static guint   _nobj   = 0;     // number of object drawn during lap
 static guint   _ncmd   = 0;     // number of command drawn during lap
 static guint   _oclip  = 0;     // number of object clipped
-static guint   _nFrag  = 0;     // number of pixel fragment (color switch)
+static guint   _nFrag  = 0;     // number of fragment attribute set (color switch)
 static int     _drgare = 0;     // DRGARE
 static int     _depare = 0;     // DEPARE
 static int     _nAC    = 0;     // total AC (Area Color)
@@ -211,6 +230,10 @@ static guint   _ntrisfan  = 0;     // area GL_TRIANGLE_FAN   count
 static guint   _nCall     = 0;
 static guint   _npoly     = 0;     // total polys
 
+#ifdef S52_USE_FRAME_STATS
+static S52_GL_stat _stat[2];       // [0]: S52_GL_DRAW, [1]: S52_GL_LAST
+#endif
+
 // debug
 //static int   _debug  = 0;
 //static int   _DEBUG  = FALSE;
@@ -350,7 +373,7 @@ static int       _findCentInside  (guint npt, pt3 *v)
 
     g_array_set_size(_vertexs, 0);
     g_array_set_size(_nvertex, 0);
-    _g_ptr_array_clear(_tmpV);
+    _g_ptr_array_clear(_tmpVcen);
 
     //gluTessProperty(_tcen, GLU_TESS_BOUNDARY_ONLY, GLU_FALSE);
 
@@ -606,6 +629,121 @@ static int       _getGratScale(double view_scale_ppm, double *majorSpacing, doub
 }
 //#endif  // 0
 
+static int       _computeCentroidPrj(guint npt, double *ppt, pt3 *ext, projUV pmin, projUV pmax)
+// fill global array _centroid from poly (PRJ), its extent (PRJ) and the view
+// Note: no global view - can run outside the main thread
+{
+    pt3 *pt = ext;
+
+    // extent inside view, compute normal centroid, no clip - anti-meridian OK
+    if ((pmin.u < pt[0].x) && (pmin.v < pt[0].y) && (pmax.u > pt[1].x) && (pmax.v > pt[1].y)) {
+        g_array_set_size(_centroids, 0);
+
+        _getCentroid(npt, (pt3*)ppt);
+        //_getCentroidClose(nptLOD1, pptLOD1);
+
+        //PRINTF("no clip: %s\n", S57_getName(geo));
+
+        return TRUE;
+    }
+
+    // CSG - Computational Solid Geometry  (clip poly)
+    {
+        _g_ptr_array_clear(_tmpVcen);
+
+        g_array_set_size(_centroids, 0);
+        g_array_set_size(_vertexs,   0);
+        g_array_set_size(_nvertex,   0);
+
+        //gluTessProperty(_tcen, GLU_TESS_BOUNDARY_ONLY, GLU_TRUE);
+
+        gluTessBeginPolygon(_tcen, NULL);
+
+        // place the area - CW (BUG: should be CCW!)
+        gluTessBeginContour(_tcen);
+
+        for (guint i=0; i<npt-1; ++i) {
+            // FIXME: filter and clip poly because very expensive for large poly and large extent(good test case:CA279037.000, IT zone)
+            // FIX: full algo: move pt to dominant meridian/para (pminmax) and delete privious if same edge
+            // if (i!=0) then (ppt-3) is the predesessor
+
+            // FIX: heuristic: probleme when line exit from the right of area objExt and then enter it for the left
+            // - ObjExt_t viewExt(pmin/pmax), ObjExt_t lineSegExt(min(x1,x2), min(y1,y2), max(x1,x2), max(y1,y2))
+            // - call S57_cmpExt(viewExt, lineSegExt);
+
+            // FIX: tesselate on GPU
+            gluTessVertex(_tcen, (GLdouble*)ppt, (void*)ppt);
+            ppt += 3;
+        }
+
+        /* LOD1
+        ptLOD1 = (pt3*)pptLOD1;
+        for (guint i=0; i<nptLOD1-1; ++i, ++ptLOD1) {
+            gluTessVertex(_tcen, (GLdouble*)ptLOD1, (void*)ptLOD1);
+        }
+        */
+
+        gluTessEndContour(_tcen);
+
+        // place the screen
+        gluTessBeginContour(_tcen);
+        {
+            GLdouble d[4*3] = {
+                pmin.u, pmin.v, 0.0,
+                pmax.u, pmin.v, 0.0,
+                pmax.u, pmax.v, 0.0,
+                pmin.u, pmax.v, 0.0,
+            };
+            GLdouble *p = NULL;
+
+            // CCW
+            /*
+            p = d;
+            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
+            p += 3;
+            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
+            p += 3;
+            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
+            p += 3;
+            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
+            */
+
+            // CW
+            p = d + (3*3);
+            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
+            p -= 3;
+            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
+            p -= 3;
+            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
+            p -= 3;
+            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
+
+        }
+        gluTessEndContour(_tcen);
+
+        // finish
+        gluTessEndPolygon(_tcen);
+
+        // compute centroid
+        {   // debug: land here is extent of area overlap but not the area itself
+            //if (0 == _nvertex->len)
+            //    PRINTF("not intersecting with screen .. !!\n");
+
+            int offset = 0;
+            for (guint i=0; i<_nvertex->len; ++i) {
+                int npt = g_array_index(_nvertex, int, i);
+                pt3 *p = &g_array_index(_vertexs, pt3, offset);
+                //_getCentroidOpen(npt-offset, p);
+                _getCentroid(npt-offset, p);
+                offset = npt;
+            }
+        }
+    }
+
+    return TRUE;
+}
+
+
 static int       _computeCentroid(S57_geo *geo)
 // return centroids
 // fill global array _centroid
@@ -703,113 +841,232 @@ User bands Navigational
 
     //PRINTF("%s VIEW EXT %f,%f -- %f,%f\n", S57_getName(geo), _pmin.u, _pmin.v, _pmax.u, _pmax.v);
 
-    // extent inside view, compute normal centroid, no clip - anti-meridian OK
-    if ((_pmin.u < pt[0].x) && (_pmin.v < pt[0].y) && (_pmax.u > pt[1].x) && (_pmax.v > pt[1].y)) {
+    return _computeCentroidPrj(npt, ppt, pt, _pmin, _pmax);
+}
+
+#ifdef S52_USE_CENTROID_BG
+// Area centroid computed by a worker off the main thread.
+// Centroids are saved in the S57_geo centroid array, keyed by view bucket and scale level,
+// the last valid centroids are drawn until the worker return the new ones.
+#define CEN_BUCKET   8.0                        // bucket size: view width / CEN_BUCKET
+#define CEN_KEY_ALL  G_GUINT64_CONSTANT(1)      // area inside view - centroid do not depend on view
+
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex _cenMutex = G_STATIC_MUTEX_INIT;
+#define CEN_LOCK    g_static_mutex_lock  (&_cenMutex)
+#define CEN_UNLOCK  g_static_mutex_unlock(&_cenMutex)
+#else
+static GMutex       _cenMutex;                  // _tcen / _tcin / _centroids
+#define CEN_LOCK    g_mutex_lock  (&_cenMutex)
+#define CEN_UNLOCK  g_mutex_unlock(&_cenMutex)
+#endif
+
+typedef struct _cenJob {
+    S57_geo *geo;      // key only - never dereferenced by the worker
+    guint    serial;   // match _cenState.pend, else result is stale
+    guint64  key;      // view bucket / scale level
+    guint    npt;
+    double  *ppt;      // copy of outer ring (PRJ)
+    pt3      ext[2];   // area extent (PRJ)
+    projUV   pmin;     // view at request time
+    projUV   pmax;
+    GArray  *cent;     // result (pt3)
+} _cenJob;
+
+typedef struct _cenState {
+    guint64  key;      // key of the centroids in S57_geo
+    guint    pend;     // serial of the job in the worker, 0 - none
+} _cenState;
+
+static GHashTable  *_cenTbl    = NULL;  // S57_geo * --> _cenState * (main thread only)
+static GThreadPool *_cenPool   = NULL;
+static GAsyncQueue *_cenDone   = NULL;  // _cenJob * done by the worker
+static guint        _cenSerial = 0;
+static volatile gint _cenQuit  = FALSE; // S52_GL_done() - worker skip remaining jobs
+
+static void      _cenJobFree(_cenJob *job)
+{
+    g_free(job->ppt);
+    if (NULL != job->cent)
+        g_array_free(job->cent, TRUE);
+    g_free(job);
+
+    return;
+}
+
+static void      _cenWorker(gpointer data, gpointer user_data)
+{
+    _cenJob *job = (_cenJob *)data;
+
+    // quiet compiler
+    (void) user_data;
+
+    if (FALSE == g_atomic_int_get(&_cenQuit)) {
+        CEN_LOCK;
         g_array_set_size(_centroids, 0);
+        _computeCentroidPrj(job->npt, job->ppt, job->ext, job->pmin, job->pmax);
+        job->cent = g_array_sized_new(FALSE, FALSE, sizeof(pt3), _centroids->len);
+        g_array_append_vals(job->cent, _centroids->data, _centroids->len);
+        CEN_UNLOCK;
+    }
 
-        _getCentroid(npt, (pt3*)ppt);
-        //_getCentroidClose(nptLOD1, pptLOD1);
+    g_async_queue_push(_cenDone, job);
 
-        //PRINTF("no clip: %s\n", S57_getName(geo));
+    return;
+}
 
-        return TRUE;
+static int       _cenSave(S57_geo *geo, GArray *cent)
+// save centroids in S57_geo
+{
+    S57_newCentroid(geo);
+
+    for (guint i=0; i<cent->len; ++i) {
+        pt3 *pt = &g_array_index(cent, pt3, i);
+        S57_addCentroid(geo, pt->x, pt->y);
+
+        // keep only one centroid
+        if (0.0 == S52_MP_get(S52_MAR_DISP_CENTROIDS))
+            break;
     }
 
-    // CSG - Computational Solid Geometry  (clip poly)
-    {
-        _g_ptr_array_clear(_tmpV);
+    return TRUE;
+}
 
-        g_array_set_size(_centroids, 0);
-        g_array_set_size(_vertexs,   0);
-        g_array_set_size(_nvertex,   0);
+static guint64   _cenViewKey(void)
+// bucket of the current view and scale level (8 per octave)
+{
+    double bsz = (_pmax.u - _pmin.u) / CEN_BUCKET;
+    if (!(0.0 < bsz))
+        return CEN_KEY_ALL + 1;
 
-        //gluTessProperty(_tcen, GLU_TESS_BOUNDARY_ONLY, GLU_TRUE);
+    gint64 bx = (gint64) floor(_pmin.u / bsz);
+    gint64 by = (gint64) floor(_pmin.v / bsz);
+    gint64 sl = (gint64) nearbyint(log2(_scalex) * 8.0);
 
-        gluTessBeginPolygon(_tcen, NULL);
+    guint64 key = ((guint64)(sl & 0xFFFF) << 48) ^ ((guint64)(bx & 0xFFFFFF) << 24) ^ (guint64)(by & 0xFFFFFF);
 
-        // place the area - CW (BUG: should be CCW!)
-        gluTessBeginContour(_tcen);
+    // 0 and CEN_KEY_ALL are reserved
+    return (CEN_KEY_ALL < key) ? key : key + 2;
+}
 
-        for (guint i=0; i<npt-1; ++i) {
-            // FIXME: filter and clip poly because very expensive for large poly and large extent(good test case:CA279037.000, IT zone)
-            // FIX: full algo: move pt to dominant meridian/para (_pminmax) and delete privious if same edge
-            // if (i!=0) then (ppt-3) is the predesessor
+static int       _cenGet(S57_geo *geo)
+// return TRUE if the centroids in S57_geo are those of this view,
+// FALSE if last valid centroids (the worker compute new ones)
+// Note: first time the area has no centroid yet, its symbol / text is skipped until the worker is done
+{
+    if (NULL == _cenTbl) {
+        _cenTbl  = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, g_free);
+        _cenDone = g_async_queue_new();
+        // one worker: _tcen / _tcin are shared anyway
+        _cenPool = g_thread_pool_new(_cenWorker, NULL, 1, FALSE, NULL);
+    }
 
-            // FIX: heuristic: probleme when line exit from the right of area objExt and then enter it for the left
-            // - ObjExt_t viewExt(_pmin/_pmax), ObjExt_t lineSegExt(min(x1,x2), min(y1,y2), max(x1,x2), max(y1,y2))
-            // - call S57_cmpExt(viewExt, lineSegExt);
+    // area clipped by view - centroid depend on view
+    ObjExt_t ext = S57_getGeoExt(geo);
+    guint64  key = CEN_KEY_ALL;
+    // Note: no need to handle anti-meridian - cell can't cross it
+    if ((ext.S < _gmin.v) || (ext.N > _gmax.v) || (ext.W < _gmin.u) || (ext.E > _gmax.u))
+        key = _cenViewKey();
 
-            // FIX: tesselate on GPU
-            gluTessVertex(_tcen, (GLdouble*)ppt, (void*)ppt);
-            ppt += 3;
-        }
+    _cenState *cs = (_cenState *)g_hash_table_lookup(_cenTbl, geo);
+    if (NULL == cs) {
+        // first time - queued as any other (no CEN_LOCK wait on the worker here),
+        // key 0 match no view
+        cs = g_new0(_cenState, 1);
+        g_hash_table_insert(_cenTbl, geo, cs);
+    }
 
-        /* LOD1
-        ptLOD1 = (pt3*)pptLOD1;
-        for (guint i=0; i<nptLOD1-1; ++i, ++ptLOD1) {
-            gluTessVertex(_tcen, (GLdouble*)ptLOD1, (void*)ptLOD1);
-        }
-        */
+    if (key == cs->key)
+        return TRUE;
 
-        gluTessEndContour(_tcen);
+    // one job per area in the worker, next one on a later frame
+    if (0 != cs->pend)
+        return FALSE;
 
-        // place the screen
-        gluTessBeginContour(_tcen);
-        {
-            GLdouble d[4*3] = {
-                _pmin.u, _pmin.v, 0.0,
-                _pmax.u, _pmin.v, 0.0,
-                _pmax.u, _pmax.v, 0.0,
-                _pmin.u, _pmax.v, 0.0,
-            };
-            GLdouble *p = NULL;
+    guint   npt = 0;
+    double *ppt = NULL;
+    if ((FALSE==S57_getGeoData(geo, 0, &npt, &ppt)) || (npt < 4))
+        return FALSE;
 
-            // CCW
-            /*
-            p = d;
-            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
-            p += 3;
-            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
-            p += 3;
-            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
-            p += 3;
-            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
-            */
+    _cenJob *job = g_new0(_cenJob, 1);
+    job->ext[0].x = ext.W;
+    job->ext[0].y = ext.S;
+    job->ext[1].x = ext.E;
+    job->ext[1].y = ext.N;
+    if (FALSE == S57_geo2prj3dv(2, job->ext)) {
+        g_free(job);
+        return FALSE;
+    }
 
-            // CW
-            p = d + (3*3);
-            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
-            p -= 3;
-            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
-            p -= 3;
-            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
-            p -= 3;
-            gluTessVertex(_tcen, (GLdouble*)p, (void*)p);
+    // 0 is no job
+    if (0 == ++_cenSerial)
+        ++_cenSerial;
 
-        }
-        gluTessEndContour(_tcen);
+    job->geo    = geo;
+    job->serial = _cenSerial;
+    job->key    = key;
+    job->npt    = npt;
+    job->ppt    = g_new(double, 3*npt);
+    memcpy(job->ppt, ppt, sizeof(double)*3*npt);
+    job->pmin   = _pmin;
+    job->pmax   = _pmax;
 
-        // finish
-        gluTessEndPolygon(_tcen);
+    cs->pend    = job->serial;
 
-        // compute centroid
-        {   // debug: land here is extent of area overlap but not the area itself
-            //if (0 == _nvertex->len)
-            //    PRINTF("not intersecting with screen .. !!\n");
+    g_thread_pool_push(_cenPool, job, NULL);
 
-            int offset = 0;
-            for (guint i=0; i<_nvertex->len; ++i) {
-                int npt = g_array_index(_nvertex, int, i);
-                pt3 *p = &g_array_index(_vertexs, pt3, offset);
-                //_getCentroidOpen(npt-offset, p);
-                _getCentroid(npt-offset, p);
-                offset = npt;
-            }
+    return FALSE;
+}
+
+static int       _cenCollect(void)
+// main thread - move the worker result in S57_geo
+{
+    if (NULL == _cenDone)
+        return FALSE;
+
+    _cenJob *job = NULL;
+    while (NULL != (job = (_cenJob *)g_async_queue_try_pop(_cenDone))) {
+        _cenState *cs = (_cenState *)g_hash_table_lookup(_cenTbl, job->geo);
+
+        // Note: area deleted (S52_GL_delDL()) while in the worker - drop
+        if ((NULL!=cs) && (job->serial==cs->pend) && (NULL!=job->cent)) {
+            _cenSave(job->geo, job->cent);
+            cs->key  = job->key;
+            cs->pend = 0;
         }
+
+        _cenJobFree(job);
+    }
+
+    return TRUE;
+}
+
+static int       _cenDoneAll(void)
+{
+    if (NULL != _cenPool) {
+        // queued jobs go straight to _cenDone
+        g_atomic_int_set(&_cenQuit, TRUE);
+        g_thread_pool_free(_cenPool, FALSE, TRUE);
+        _cenPool = NULL;
+        g_atomic_int_set(&_cenQuit, FALSE);
+    }
+
+    if (NULL != _cenDone) {
+        _cenJob *job = NULL;
+        while (NULL != (job = (_cenJob *)g_async_queue_try_pop(_cenDone)))
+            _cenJobFree(job);
+        g_async_queue_unref(_cenDone);
+        _cenDone = NULL;
+    }
+
+    if (NULL != _cenTbl) {
+        g_hash_table_destroy(_cenTbl);
+        _cenTbl = NULL;
     }
 
     return TRUE;
 }
+#endif  // S52_USE_CENTROID_BG
 
 
 static void      _glMatrixMode(GLenum  mode)
@@ -1461,6 +1718,15 @@ static int       _VBODrawArrays_AREA(S57_prim *prim)
             g_assert(0);
         } else {
             glDrawArrays(mode, first, count);
+
+#ifdef S52_USE_FRAME_STATS
+            switch (mode) {
+                case GL_TRIANGLE_STRIP: ++_ntristrip; break;
+                case GL_TRIANGLE_FAN:   ++_ntrisfan;  break;
+                case GL_TRIANGLES:      _ntris += count / 3; break;
+                default: break;
+            }
+#endif
         }
     }
 
@@ -1641,6 +1907,58 @@ static int       _fillArea(S57_geo *geo)
     return TRUE;
 }
 
+#ifdef S52_USE_AC_BATCH
+// AC() of static area merged in one VBO per cell
+// Note: triangle list (no index) - GLES2 index is 16 bits
+typedef struct _ACrange {
+    S52_obj *obj;
+    GLint    first;      // first vertex in batch VBO
+    GLsizei  count;      // number of vertex
+    guint    stamp;      // == _acStamp: culled in, drawn by the batch
+} _ACrange;
+
+typedef struct _ACbin {
+    S52_disPrio prio;
+    S52_RadPrio radPrio;
+    guchar      cidx;    // color index in palette
+    char        trans;
+    GLint       first;   // first vertex of this bin in batch VBO
+    GArray     *vertex;  // xyz - free'd when uploaded
+    GArray     *range;   // _ACrange in renderBin order
+} _ACbin;
+
+struct _S52_GL_ACbatch {
+    GPtrArray  *bins;      // _ACbin
+    GHashTable *objRange;  // S52_obj --> _ACrange
+    GLuint      vboID;
+};
+
+static guint           _acStamp     = 0;     // stamp of the journal segment drawn by a batch
+static S52_GL_ACbatch *_acBatchCrnt = NULL;  // batch of the journal segment, see S52_GL_drawACbatch()
+
+static int       _ACbatchDone(S52_obj *obj)
+// TRUE if AC() of obj has been drawn by the batch of this journal segment
+{
+    if (NULL == _acBatchCrnt)
+        return FALSE;
+
+    _ACrange *r = (_ACrange *)g_hash_table_lookup(_acBatchCrnt->objRange, obj);
+    if ((NULL!=r) && (_acStamp==r->stamp))
+        return TRUE;
+
+    return FALSE;
+}
+
+static int       _ACbatchAddTri(GArray *vertex, vertex_t *vert, int a, int b, int c)
+{
+    g_array_append_vals(vertex, vert + a*3, 1);
+    g_array_append_vals(vertex, vert + b*3, 1);
+    g_array_append_vals(vertex, vert + c*3, 1);
+
+    return 3;
+}
+#endif  // S52_USE_AC_BATCH
+
 
 //---------------------------------------
 //
@@ -1665,6 +1983,15 @@ typedef union cIdx {
 } cIdx;
 static cIdx _cIdx;
 
+#ifdef S52_USE_PICK_GEO
+static vp_t _pickVP;  // pick viewport, read back at S52_GL_end(S52_GL_PICK)
+
+// _pickGEO() verdict
+#define PICK_GEO_OUT 0  // geometry not in pick extent
+#define PICK_GEO_IN  1  // geometry in pick extent
+#define PICK_GEO_GPU 2  // can't tell (symbol cover, light sector, ..) - render color index
+#endif
+
 //#define _pixelsReadDim 1
 //#define _pixelsReadDim 4
 //#define _pixelsReadDim 8
@@ -1709,6 +2036,10 @@ static int       _glColor4ub(GLubyte r, GLubyte g, GLubyte b, GLubyte a)
 #ifdef S52_USE_GL2
     GLfloat alpha = (4 - (a - '0')) * TRNSP_FAC_GLES2;
     glUniform4f(_uColor, r/255.0, g/255.0, b/255.0, alpha);
+#ifdef S52_USE_PAL_IDX
+    // not a palette color - fragment use uColor
+    glVertexAttrib2f(_aCIdx, -1.0, alpha);
+#endif
 #else
     GLbyte alpha = (4 - (a - '0')) * TRNSP_FAC;
     glColor4ub(r, g, b, alpha);
@@ -1723,6 +2054,8 @@ static GLubyte   _setFragAttrib(S52_Color *c, gboolean highlight)
 // set fragment attributes: color/highlight, trans, pen_w
 // return transparancy/alpha
 {
+    ++_nFrag;
+
     if (S52_GL_PICK == _crnt_GL_cycle) {
         // opaque
         _glColor4ub(_cIdx.color.r, _cIdx.color.g, _cIdx.color.b, '0');
@@ -1731,6 +2064,17 @@ static GLubyte   _setFragAttrib(S52_Color *c, gboolean highlight)
     }
 
     // FIXME: red / yellow (danger / warning)
+#if defined(S52_USE_GL2) && defined(S52_USE_PAL_IDX)
+    if (TRUE == highlight) {
+        // reset color if highlighting (pick / alarm / indication)
+        S52_Color dnghlcol = *S52_PL_getColor("DNGHL");
+        dnghlcol.fragAtt.trans = c->fragAtt.trans;
+        _glColorPal(&dnghlcol);
+    } else {
+        // normal
+        _glColorPal(c);
+    }
+#else
     if (TRUE == highlight) {
         // reset color if highlighting (pick / alarm / indication)
         S52_Color *dnghlcol = S52_PL_getColor("DNGHL");
@@ -1739,6 +2083,7 @@ static GLubyte   _setFragAttrib(S52_Color *c, gboolean highlight)
         // normal
         _glColor4ub(c->R, c->G, c->B, c->fragAtt.trans);
     }
+#endif
 
     if (('0'!=c->fragAtt.trans) && (TRUE==(int) S52_MP_get(S52_MAR_ANTIALIAS))) {
         // FIXME: blending always ON
@@ -1831,7 +2176,7 @@ static int       _glCallList(S52_DListData *DListData)
                 } else {
                     // debug - test filter at GL level instead of CmdWord level
                     if (S52_CMD_WRD_FILTER_SY & (int) S52_MP_get(S52_CMD_WRD_FILTER)) {
-                        ++_nFrag;
+                        // skip
                     } else {
                         /* debug - merging of point/line/strip
                         if (mode = GL_LINES) {
@@ -1893,6 +2238,173 @@ static int       _glCallList(S52_DListData *DListData)
     return TRUE;
 }
 
+#ifdef S52_USE_SY_INST
+static int       _SYinstAdd(S52_DListData *DListData, double x, double y, double rotation)
+// queue a point symbol - FALSE if it must be drawn now
+{
+    if ((S52_GL_DRAW!=_crnt_GL_cycle) || (NULL==DListData))
+        return FALSE;
+
+    if (NULL == _SYinstList) {
+        _SYinstList = g_ptr_array_new();
+        _SYinstIdx  = g_hash_table_new(g_direct_hash, g_direct_equal);
+    }
+
+    _SYinst *s = (_SYinst *)g_hash_table_lookup(_SYinstIdx, DListData);
+    if (NULL == s) {
+        s            = g_new0(_SYinst, 1);
+        s->DListData = DListData;
+        s->ok        = TRUE;
+        s->inst      = g_array_new(FALSE, FALSE, sizeof(GLfloat)*4);
+
+        // sub-symbol translation need a matrix per prim
+        for (guint i=0; i<DListData->nbr; ++i) {
+            GLint mode  = 0;
+            GLint first = 0;
+            GLint count = 0;
+            for (guint j=0; TRUE==S57_getPrimIdx(DListData->prim[i], j, &mode, &first, &count); ++j) {
+                if (_TRANSLATE == mode)
+                    s->ok = FALSE;
+            }
+        }
+
+        g_ptr_array_add(_SYinstList, s);
+        g_hash_table_insert(_SYinstIdx, DListData, s);
+    }
+
+    if (FALSE == s->ok)
+        return FALSE;
+
+    double  rad = rotation * DEG_TO_RAD;
+    GLfloat v[4] = {x, y, cos(rad), sin(rad)};
+    g_array_append_val(s->inst, v);
+    ++_SYinstN;
+
+    return TRUE;
+}
+
+static int       _SYinstFlush(void)
+// draw queued symbol, one call per primitive of a symbol (or per instance as fallback)
+{
+    if (0 == _SYinstN)
+        return FALSE;
+
+    int instanced = ((TRUE==_GL_EXT_instanced_arrays) && (NULL!=_glDrawArraysInstancedEXT)) ? TRUE : FALSE;
+
+    _glUniformMatrix4fv_uModelview();
+    glUniform1f(_uInstOn, 1.0);
+    // see _pushScaletoPixel(TRUE) and _renderSY_POINT_T()
+    glUniform2f(_uInstScale,
+                 _scalex / (S52_MP_get(S52_MAR_DOTPITCH_MM_X) * 100.0),
+                -_scaley / (S52_MP_get(S52_MAR_DOTPITCH_MM_Y) * 100.0));
+
+    // no face culling as symbol can be both CW,CCW (see _glCallList())
+    glDisable(GL_CULL_FACE);
+    glEnableVertexAttribArray(_aPosition);
+
+    if ((TRUE==instanced) && (0==_SYinstVBO))
+        glGenBuffers(1, &_SYinstVBO);
+
+    for (guint k=0; k<_SYinstList->len; ++k) {
+        _SYinst *s = (_SYinst *)g_ptr_array_index(_SYinstList, k);
+        if (0 == s->inst->len)
+            continue;
+
+        S52_DListData *DListData = s->DListData;
+        GLfloat       *inst      = (GLfloat *)s->inst->data;
+        GLsizei        n         = s->inst->len;
+
+        if (TRUE == instanced) {
+            glBindBuffer(GL_ARRAY_BUFFER, _SYinstVBO);
+            glBufferData(GL_ARRAY_BUFFER, n*sizeof(GLfloat)*4, inst, GL_STREAM_DRAW);
+            glEnableVertexAttribArray(_aInst);
+            glVertexAttribPointer(_aInst, 4, GL_FLOAT, GL_FALSE, 0, 0);
+            _glVertexAttribDivisorEXT(_aInst, 1);
+        }
+
+        for (guint i=0; i<DListData->nbr; ++i) {
+            _setFragAttrib(&DListData->colors[i], FALSE);
+
+            glBindBuffer(GL_ARRAY_BUFFER, DListData->vboIds[i]);
+            glVertexAttribPointer(_aPosition, 3, GL_FLOAT, GL_FALSE, 0, 0);
+
+            GLint mode  = 0;
+            GLint first = 0;
+            GLint count = 0;
+            if (TRUE == instanced) {
+                for (guint j=0; TRUE==S57_getPrimIdx(DListData->prim[i], j, &mode, &first, &count); ++j) {
+                    _glDrawArraysInstancedEXT(mode, first, count, n);
+#ifdef S52_USE_FRAME_STATS
+                    ++_nDrawCall;
+                    _nVertex += count * n;
+#endif
+                }
+            } else {
+                for (GLsizei m=0; m<n; ++m) {
+                    glVertexAttrib4fv(_aInst, inst + m*4);
+                    for (guint j=0; TRUE==S57_getPrimIdx(DListData->prim[i], j, &mode, &first, &count); ++j)
+                        glDrawArrays(mode, first, count);
+                }
+            }
+        }
+
+        if (TRUE == instanced) {
+            _glVertexAttribDivisorEXT(_aInst, 0);
+            glDisableVertexAttribArray(_aInst);
+        }
+
+        g_array_set_size(s->inst, 0);
+    }
+    _SYinstN = 0;
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glDisableVertexAttribArray(_aPosition);
+    glUniform1f(_uInstOn, 0.0);
+    glEnable(GL_CULL_FACE);
+
+    _checkError("_SYinstFlush()");
+
+    return TRUE;
+}
+
+static int       _SYinstReset(void)
+// forget symbol definition (DListData can be rebuild between cycle)
+{
+    if (NULL == _SYinstList)
+        return FALSE;
+
+    for (guint k=0; k<_SYinstList->len; ++k) {
+        _SYinst *s = (_SYinst *)g_ptr_array_index(_SYinstList, k);
+        g_array_free(s->inst, TRUE);
+        g_free(s);
+    }
+    g_ptr_array_set_size(_SYinstList, 0);
+    g_hash_table_remove_all(_SYinstIdx);
+    _SYinstN = 0;
+
+    return TRUE;
+}
+
+static int       _SYinstDone(void)
+{
+    _SYinstReset();
+
+    if (NULL != _SYinstList) {
+        g_ptr_array_free(_SYinstList, TRUE);
+        g_hash_table_destroy(_SYinstIdx);
+        _SYinstList = NULL;
+        _SYinstIdx  = NULL;
+    }
+
+    if (0 != _SYinstVBO) {
+        glDeleteBuffers(1, &_SYinstVBO);
+        _SYinstVBO = 0;
+    }
+
+    return TRUE;
+}
+#endif  // S52_USE_SY_INST
+
 static int       _getVesselVector(S52_obj *obj, double *course, double *speed)
 // return TRUE and course, speed, else FALSE
 {
@@ -1937,6 +2449,12 @@ static int       _renderSY_POINT_T(S52_obj *obj, double x, double y, double rota
 {
     S52_DListData *DListData = S52_PL_getDListData(obj);
 
+#ifdef S52_USE_SY_INST
+    // drawn at the end of this display priority - see S52_GL_flushSY()
+    if (TRUE == _SYinstAdd(DListData, x, y, rotation))
+        return TRUE;
+#endif
+
     _glLoadIdentity(GL_MODELVIEW);
 
     _glTranslated(x, y, 0.0);
@@ -2866,6 +3384,18 @@ static int       _renderSY(S52_obj *obj)
         }
 
 
+#ifdef S52_USE_CENTROID_BG
+        {   // normal draw - centroid of this view or last valid one while the worker compute it
+            _cenGet(geo);
+
+            if (TRUE == S57_hasCentroid(geo)) {
+                double x,y;
+                while (TRUE == S57_getNextCent(geo, &x, &y)) {
+                    _renderSY_POINT_T(obj, x, y, orient);
+                }
+            }
+        }
+#else
         {   // normal draw, also fill centroid
             double offset_x;
             double offset_y;
@@ -2929,6 +3459,7 @@ static int       _renderSY(S52_obj *obj)
                     return TRUE;
             }
         }
+#endif  // S52_USE_CENTROID_BG
 
         return TRUE;
     }
@@ -3534,7 +4065,11 @@ static int       _renderLS(S52_obj *obj)
                 {
 
 #ifdef S52_USE_GL2
+#ifdef S52_USE_OPENGL_VBO
+                    _renderLS_gl2VBO(geo, style, npt, ppt);
+#else
                     _renderLS_gl2(style, npt, ppt);
+#endif
 #else
                     //_glUniformMatrix4fv_uModelview();
                     _glLoadIdentity(GL_MODELVIEW);
@@ -3809,6 +4344,161 @@ static int       _renderLCring(S52_obj *obj, guint ringNo, double symlen_wrld)
     return TRUE;
 }
 
+#ifdef S52_USE_LC_CACHE
+// LC() symbol placement of a static line / area, for one scale level
+// Note: placed on the whole ring (not clipped to view) so symbols don't crawl when panning
+// Note: zoomed in, a long ring hold too many symbols - above LC_CACHE_MAX the obj is not
+// cached at this level and _renderLC() fall back to the clipped path (_renderLCring())
+typedef struct _LCcache {
+    double  symlen_wrld;   // symbol length at the quantized scale
+    gboolean over;         // TRUE more than LC_CACHE_MAX symbols at this level - not cached
+    GArray *inst;          // pt3: x, y, segment angle (deg) of each symbol
+    GArray *ends;          // pt3v: line left after the last symbol of each segment (GL_LINES)
+} _LCcache;
+static GHashTable *_LCcacheTbl = NULL;  // S52_obj * --> _LCcache *
+
+// scale level: 1/64 octave - symbols gap / overlap at most ~1% of their length
+#define LC_CACHE_STEP 64.0
+// max symbols cached per obj
+#define LC_CACHE_MAX  4096
+
+static void      _LCcacheFree(gpointer data)
+{
+    _LCcache *lc = (_LCcache *)data;
+
+    g_array_free(lc->inst, TRUE);
+    g_array_free(lc->ends, TRUE);
+    g_free(lc);
+
+    return;
+}
+
+static int       _LCcacheRing(_LCcache *lc, S57_geo *geo, guint ringNo)
+{
+    pt3   *ppt = NULL;
+    guint  npt = 0;
+    if (FALSE == S57_getGeoData(geo, ringNo, &npt, (double**)&ppt))
+        return FALSE;
+
+    for (guint i=1; i<npt; ++i, ++ppt) {
+        pt3 p1 = ppt[0];
+        pt3 p2 = ppt[1];
+
+        // overlapping Line Complex (LC) suppression
+        if (-S57_OVERLAP_GEO_Z==p1.z && -S57_OVERLAP_GEO_Z==p2.z)
+            continue;
+
+        double seglen_wrld   = sqrt(pow(p1.x-p2.x, 2) + pow(p1.y-p2.y, 2));
+        double segang        = atan2(p2.y-p1.y, p2.x-p1.x);
+        double symlen_wrld_x = cos(segang) * lc->symlen_wrld;
+        double symlen_wrld_y = sin(segang) * lc->symlen_wrld;
+        int    nsym          = (int) (seglen_wrld / lc->symlen_wrld);
+
+        // too many symbols - bail out
+        if (LC_CACHE_MAX < (lc->inst->len + nsym)) {
+            lc->over = TRUE;
+            return FALSE;
+        }
+
+        for (int j=0; j<nsym; ++j) {
+            pt3 pos = {p1.x + j*symlen_wrld_x, p1.y + j*symlen_wrld_y, segang * RAD_TO_DEG};
+            g_array_append_val(lc->inst, pos);
+        }
+
+        pt3v pt[2] = {{p1.x + nsym*symlen_wrld_x, p1.y + nsym*symlen_wrld_y, p1.z}, {p2.x, p2.y, p2.z}};
+        g_array_append_vals(lc->ends, pt, 2);
+    }
+
+    return TRUE;
+}
+
+static _LCcache *_LCcacheGet(S52_obj *obj, double symlen_pixl)
+// placement of this obj at the current scale level, rebuilt on level / dot pitch change
+// return NULL if this obj has more than LC_CACHE_MAX symbols at this level
+{
+    double    symlen_wrld = symlen_pixl * exp2(nearbyint(log2(_scalex) * LC_CACHE_STEP) / LC_CACHE_STEP);
+    _LCcache *lc          = NULL;
+
+    if (NULL == _LCcacheTbl)
+        _LCcacheTbl = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, _LCcacheFree);
+    else
+        lc = (_LCcache *)g_hash_table_lookup(_LCcacheTbl, obj);
+
+    if ((NULL!=lc) && (symlen_wrld==lc->symlen_wrld))
+        return (TRUE==lc->over) ? NULL : lc;
+
+    if (NULL == lc) {
+        lc       = g_new0(_LCcache, 1);
+        lc->inst = g_array_new(FALSE, FALSE, sizeof(pt3));
+        lc->ends = g_array_new(FALSE, FALSE, sizeof(pt3v));
+        g_hash_table_insert(_LCcacheTbl, obj, lc);
+    }
+
+    lc->symlen_wrld = symlen_wrld;
+    lc->over        = FALSE;
+    g_array_set_size(lc->inst, 0);
+    g_array_set_size(lc->ends, 0);
+
+    S57_geo *geo  = S52_PL_getGeo(obj);
+    guint    rNbr = S57_getRingNbr(geo);
+    for (guint i=0; (i<rNbr) && (FALSE==lc->over); ++i)
+        _LCcacheRing(lc, geo, i);
+
+    if (TRUE == lc->over) {
+        // keep the entry (level) but not the symbols
+        g_array_set_size(lc->inst, 0);
+        g_array_set_size(lc->ends, 0);
+        return NULL;
+    }
+
+    return lc;
+}
+
+static int       _renderLCcache(S52_obj *obj, _LCcache *lc)
+{
+    S52_DListData *DListData = S52_PL_getDListData(obj);
+    double         m         = lc->symlen_wrld;
+#ifdef S52_USE_SY_INST
+    gboolean       inst      = !S57_getHighlight(S52_PL_getGeo(obj));
+#endif
+
+    pt3 *p = (pt3 *)lc->inst->data;
+    for (guint i=0; i<lc->inst->len; ++i, ++p) {
+        // symbol outside view
+        if ((p->x+m < _pmin.u) || (p->x-m > _pmax.u) || (p->y+m < _pmin.v) || (p->y-m > _pmax.v))
+            continue;
+
+#ifdef S52_USE_SY_INST
+        // Note: SY rotate before the Y flip, hence -angle (see _renderSY_POINT_T())
+        if ((TRUE==inst) && (TRUE==_SYinstAdd(DListData, p->x, p->y, -p->z)))
+            continue;
+#endif
+
+        _glLoadIdentity(GL_MODELVIEW);
+
+        _glTranslated(p->x, p->y, 0.0);       // move coord sys. at symb pos.
+        _glRotated(p->z, 0.0, 0.0, 1.0);      // rotate coord sys. on Z
+        _glScaled(1.0, -1.0, 1.0);
+
+        _pushScaletoPixel(TRUE);
+
+        _glCallList(DListData);
+
+        _popScaletoPixel();
+    }
+
+    // set identity matrix
+    _glUniformMatrix4fv_uModelview();
+
+    // render all lines ending
+    _DrawArrays_LINES(lc->ends->len, (vertex_t*)lc->ends->data);
+
+    _checkError("_renderLCcache()");
+
+    return TRUE;
+}
+#endif  // S52_USE_LC_CACHE
+
 static int       _drawArc(S52_obj *objA, S52_obj *objB);  // forward decl
 static int       _renderLC(S52_obj *obj)
 // Line Complex (AREA, LINE)
@@ -3881,6 +4571,21 @@ static int       _renderLC(S52_obj *obj)
     GLdouble symlen_pixl = symlen / (100.0 * S52_MP_get(S52_MAR_DOTPITCH_MM_X));
     GLdouble symlen_wrld = symlen_pixl * _scalex;
 
+#ifdef S52_USE_LC_CACHE
+    // static ENC line / area - leglin is trimmed at each draw
+    if ((FALSE==S57_getGeoDyn(geo)) && (0!=g_strcmp0("leglin", S57_getName(geo)))) {
+        _LCcache *lc = _LCcacheGet(obj, symlen_pixl);
+        if (NULL != lc) {
+            _renderLCcache(obj, lc);
+
+            _checkError("_renderLC()");
+
+            return TRUE;
+        }
+        // else too many symbols at this level - clipped path
+    }
+#endif
+
     guint rNbr = S57_getRingNbr(geo);
     for (guint i=0; i<rNbr; ++i) {
         _renderLCring(obj, i, symlen_wrld);
@@ -4125,6 +4830,12 @@ static int       _renderAC(S52_obj *obj)
     if (S52_CMD_WRD_FILTER_AC & (int) S52_MP_get(S52_CMD_WRD_FILTER))
         return TRUE;
 
+#ifdef S52_USE_AC_BATCH
+    // allready drawn by the batch of this cell
+    if (TRUE == _ACbatchDone(obj))
+        return TRUE;
+#endif
+
     S52_Color *c   = S52_PL_getACdata(obj);
     S57_geo   *geo = S52_PL_getGeo(obj);
 
@@ -4422,6 +5133,9 @@ static int       _renderTXTAA(S52_obj *obj, S52_Color *color, double x, double y
     double strHpx = 0.0;
     char   hjust  = '3';  // LEFT   (default)
     char   vjust  = '1';  // BOTTOM (default)
+#ifdef S52_USE_TXT_BATCH
+    GLuint glyphVBO = 0;  // key of the glyph CPU copy
+#endif
 
     if ((NULL!=obj) && (S52_GL_DRAW==_crnt_GL_cycle)) {
         GLuint vboID = S52_PL_getFreetypeGL_VBO(obj, &len, &strWpx, &strHpx, &hjust, &vjust);
@@ -4455,7 +5169,20 @@ static int       _renderTXTAA(S52_obj *obj, S52_Color *color, double x, double y
                          _freetype_gl_buffer->len * sizeof(_freetype_gl_vertex_t),
                          (const void *)_freetype_gl_buffer->data,
                          GL_STATIC_DRAW);
+
+#ifdef S52_USE_TXT_BATCH
+            // keep glyph on CPU - GLES2 can't read back a VBO
+            if (NULL == _txtGlyph)
+                _txtGlyph = g_hash_table_new_full(g_direct_hash, g_direct_equal, NULL, (GDestroyNotify)g_array_unref);
+
+            GArray *glyph = g_array_sized_new(FALSE, FALSE, sizeof(_freetype_gl_vertex_t), len);
+            g_array_append_vals(glyph, _freetype_gl_buffer->data, len);
+            g_hash_table_replace(_txtGlyph, GUINT_TO_POINTER(vboID), glyph);
+#endif
         }
+#ifdef S52_USE_TXT_BATCH
+        glyphVBO = vboID;
+#endif
     }
 
     // graticule
@@ -4492,6 +5219,22 @@ static int       _renderTXTAA(S52_obj *obj, S52_Color *color, double x, double y
     _justifyTXTPos(strWpx, strHpx, hjust, vjust, &x, &y);
     //PRINTF("DEBUG: pos XY: %f/%f H/V: %c %c (%s)\n", x, y, hjust, vjust, str);
 
+#ifdef S52_USE_TXT_BATCH
+    // static chart text - drawn with all the text of the cell, see S52_GL_flushTXT()
+    if ((0!=glyphVBO) && (NULL!=_txtGlyph)) {
+        GArray *glyph = (GArray *)g_hash_table_lookup(_txtGlyph, GUINT_TO_POINTER(glyphVBO));
+        if (NULL != glyph) {
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+#ifdef S52_USE_TXT_SHADOW
+            _TXTbatchAdd(S52_PL_getColor("UIBCK"), FALSE, TRUE, glyph, x+_scalex, y-_scaley);
+#endif
+            _TXTbatchAdd(color, S57_getHighlight(S52_PL_getGeo(obj)), FALSE, glyph, x, y);
+
+            return TRUE;
+        }
+    }
+#endif
+
 #ifdef S52_USE_TXT_SHADOW
     //if (NULL != color)
     {
@@ -4815,6 +5558,19 @@ static int       _renderTXT(S52_obj *obj)
 
     if (S57_AREAS_T == S57_getObjtype(geo)) {
 
+#ifdef S52_USE_CENTROID_BG
+        _cenGet(geo);
+
+        if (TRUE == S57_hasCentroid(geo)) {
+            double x,y;
+            while (TRUE == S57_getNextCent(geo, &x, &y)) {
+                _renderTXTAA(obj, color, x+uoffs, y-voffs, bsize, str);
+            }
+        }
+
+        return TRUE;
+#endif
+
         _computeCentroid(geo);
 
         for (guint i=0; i<_centroids->len; ++i) {
@@ -5687,10 +6443,10 @@ int        S52_GL_drawRaster(S52_GL_ras *raster)
     if (TRUE == raster->isRADAR) {
         // "RADHI", "RADLO"
         S52_Color *radhi = S52_PL_getColor("RADHI");
-        glUniform4f(_uColor, radhi->R/255.0, radhi->G/255.0, radhi->B/255.0, (4 - (radhi->fragAtt.trans - '0'))*TRNSP_FAC_GLES2);
+        _glColor4ub(radhi->R, radhi->G, radhi->B, radhi->fragAtt.trans);
     } else {
         S52_Color *dnghl = S52_PL_getColor("DNGHL");
-        glUniform4f(_uColor, dnghl->R/255.0, dnghl->G/255.0, dnghl->B/255.0, (4 - (dnghl->fragAtt.trans - '0'))*TRNSP_FAC_GLES2);
+        _glColor4ub(dnghl->R, dnghl->G, dnghl->B, dnghl->fragAtt.trans);
     }
 
     // to fit an image in a POT texture
@@ -5762,7 +6518,167 @@ int        S52_GL_drawText(S52_obj *obj, gpointer user_data)
     return TRUE;
 }
 
+#ifndef S52_USE_PICK_GEO
 static int       _pickFBPixels(S52_obj *obj);  // forward decl.
+#endif
+
+#ifdef S52_USE_PICK_GEO
+static int       _pickAdd(S52_obj *obj, GLubyte colr)
+{
+    g_ptr_array_add(_objPick,    obj);
+    g_array_append_val(_objPickCol, colr);
+
+    return TRUE;
+}
+
+static int       _pickGEO(S52_obj *obj)
+// cursor pick on CPU - test geometry against pick extent
+// return PICK_GEO_IN/OUT, or PICK_GEO_GPU when only rendering can tell
+{
+    S57_geo *geo = S52_PL_getGeo(obj);
+
+    // pick extent (PRJ) - S52_pickAt() set it to PIXELS_WH pixels around the cursor
+    double x  = (_pmin.u + _pmax.u) / 2.0;
+    double y  = (_pmin.v + _pmax.v) / 2.0;
+    double dx = (_pmax.u - _pmin.u) / 2.0;
+    double dy = (_pmax.v - _pmin.v) / 2.0;
+
+    guint   npt = 0;
+    double *ppt = NULL;
+
+    switch (S57_getObjtype(geo)) {
+        case S57_AREAS_T: {
+            // area is filled in pick mode (see _renderLS())
+            if (TRUE == S57_isPtInArea(geo, x, y))
+                return PICK_GEO_IN;
+
+            guint nr = S57_getRingNbr(geo);
+            for (guint i=0; i<nr; ++i) {
+                if (TRUE == S57_getGeoData(geo, i, &npt, &ppt)) {
+                    if (TRUE == S57_isPtNearRing(npt, (pt3*)ppt, x, y, dx, dy))
+                        return PICK_GEO_IN;
+                }
+            }
+
+            return PICK_GEO_OUT;
+        }
+
+        case S57_LINES_T: {
+            if (TRUE == S57_getGeoData(geo, 0, &npt, &ppt)) {
+                if (TRUE == S57_isPtNearRing(npt, (pt3*)ppt, x, y, dx, dy))
+                    return PICK_GEO_IN;
+            }
+
+            return PICK_GEO_OUT;
+        }
+
+        case S57_POINT_T: {
+            // symbol cover (mm)
+            double cover = 0.0;
+
+            S52_CmdWrd cmdWrd = S52_PL_iniCmd(obj);
+            while (S52_CMD_NONE != cmdWrd) {
+                switch (cmdWrd) {
+                    case S52_CMD_SYM_PT: {
+                        // bbox in 0.01 mm - pivot anywhere in bbox
+                        int w = 0;
+                        int h = 0;
+                        if (TRUE == S52_PL_getSYbbox(obj, &w, &h)) {
+                            double r = sqrt((double)(w*w + h*h)) / 100.0;
+                            if (cover < r)
+                                cover = r;
+                        }
+                        break;
+                    }
+
+                    // light sector, ownship vector, .. lenght not in PLib
+                    case S52_CMD_SIM_LN:
+                    case S52_CMD_COM_LN: return PICK_GEO_GPU;
+
+                    default: break;
+                }
+
+                cmdWrd = S52_PL_getCmdNext(obj);
+            }
+
+            if (FALSE == S57_getGeoData(geo, 0, &npt, &ppt))
+                return PICK_GEO_OUT;
+
+            // pivot in pick extent
+            // Note: point by point (ex: SOUNDG multi-point)
+            for (guint i=0; i<npt; ++i) {
+                if (TRUE == S57_isPtNearRing(1, (pt3*)(ppt+i*3), x, y, dx, dy))
+                    return PICK_GEO_IN;
+            }
+
+            // symbol cover in pick extent - only pixels can tell
+            if (0.0 < cover) {
+                double cx = (cover / _dotpitch_mm_x) * _scalex;
+                double cy = (cover / _dotpitch_mm_y) * _scaley;
+                for (guint i=0; i<npt; ++i) {
+                    if (TRUE == S57_isPtNearRing(1, (pt3*)(ppt+i*3), x, y, dx+cx, dy+cy))
+                        return PICK_GEO_GPU;
+                }
+            }
+
+            return PICK_GEO_OUT;
+        }
+
+        default: break;
+    }
+
+    return PICK_GEO_GPU;
+}
+
+static int       _pickFBPixelsOnce(void)
+// read pick viewport once at the end of the pick cycle
+// then remove obj rendered in color index (PICK_GEO_GPU) that are not in the pixels
+// Note: obj overdrawn by an other PICK_GEO_GPU obj are lost
+{
+    guint nGPU = 0;
+    for (guint i=0; i<_objPickCol->len; ++i) {
+        if (0 != g_array_index(_objPickCol, GLubyte, i))
+            ++nGPU;
+    }
+
+    if (0 == nGPU)
+        return TRUE;
+
+    int  pixelsReadSz = _pickVP.w * _pickVP.h;
+    cIdx pixelsRead[pixelsReadSz];
+    memset(pixelsRead, 0, sizeof(pixelsRead));
+
+#ifdef S52_USE_GLSC2
+    _glReadnPixels(_pickVP.x-(_pickVP.w/2), _pickVP.y-(_pickVP.h/2), _pickVP.w, _pickVP.h, GL_RGBA, GL_UNSIGNED_BYTE, sizeof(pixelsRead), pixelsRead);
+#else
+    glReadPixels(_pickVP.x-(_pickVP.w/2), _pickVP.y-(_pickVP.h/2), _pickVP.w, _pickVP.h, GL_RGBA, GL_UNSIGNED_BYTE, pixelsRead);
+#endif
+    _checkError("_pickFBPixelsOnce():glReadPixels()");
+
+    gboolean found[256];
+    memset(found, FALSE, sizeof(found));
+    for (int i=0; i<pixelsReadSz; ++i)
+        found[pixelsRead[i].color.r] = TRUE;
+
+    // compact - keep draw order (top obj last)
+    guint n = 0;
+    for (guint i=0; i<_objPick->len; ++i) {
+        GLubyte colr = g_array_index(_objPickCol, GLubyte, i);
+        if (0==colr || TRUE==found[colr]) {
+            g_ptr_array_index(_objPick,    n) = g_ptr_array_index(_objPick, i);
+            g_array_index(_objPickCol, GLubyte, n) = colr;
+            ++n;
+        }
+    }
+    g_ptr_array_set_size(_objPick, n);
+    g_array_set_size(_objPickCol,  n);
+
+    PRINTF("DEBUG: pick read back: %i obj rendered, %i obj picked\n", nGPU, n);
+
+    return TRUE;
+}
+#endif  // S52_USE_PICK_GEO
+
 int        S52_GL_draw(S52_obj *obj, gpointer user_data)
 // draw all
 // later redraw only dirty region
@@ -5823,6 +6739,15 @@ int        S52_GL_draw(S52_obj *obj, gpointer user_data)
         }
 
         PRINTF("DEBUG: %i - pick: %s:%c:%i\n", _cIdx.color.r, S52_PL_getOBCL(obj), S57_getObjtype(geo), S57_getS57ID(geo));
+
+#ifdef S52_USE_PICK_GEO
+        // pick on CPU, render only if geometry can't tell
+        switch (_pickGEO(obj)) {
+            case PICK_GEO_OUT: return TRUE;
+            case PICK_GEO_IN : _pickAdd(obj, 0); return TRUE;
+            default: break;
+        }
+#endif
     }
 
     ++_nobj;
@@ -5860,14 +6785,305 @@ int        S52_GL_draw(S52_obj *obj, gpointer user_data)
 
     //if (S52_GL_PICK==_crnt_GL_cycle && 1.0!=S52_MP_get(S52_MAR_DISP_CRSR_PICK)) {
     if (S52_GL_PICK==_crnt_GL_cycle)  {
+#ifdef S52_USE_PICK_GEO
+        // check color at S52_GL_end()
+        _pickAdd(obj, _cIdx.color.r);
+
+        // next color / idx - 0 is geometry pick
+        if (0 == ++_cIdx.color.r)
+            ++_cIdx.color.r;
+#else
         _pickFBPixels(obj);
 
         // next color / idx
         ++_cIdx.color.r;
+#endif
+    }
+
+    return TRUE;
+}
+
+#ifdef S52_USE_SY_INST
+int        S52_GL_flushSY(void)
+{
+    return _SYinstFlush();
+}
+#endif
+
+#ifdef S52_USE_TXT_BATCH
+int        S52_GL_flushTXT(void)
+{
+    return _TXTbatchFlush();
+}
+#endif
+
+#ifdef S52_USE_AC_BATCH
+S52_GL_ACbatch *S52_GL_newACbatch(void)
+{
+    S52_GL_ACbatch *batch = g_new0(S52_GL_ACbatch, 1);
+
+    batch->bins     = g_ptr_array_new();
+    batch->objRange = g_hash_table_new(g_direct_hash, g_direct_equal);
+
+    return batch;
+}
+
+int        S52_GL_addACbatch(S52_GL_ACbatch *batch, S52_obj *obj)
+// merge the tessellated AC() of a static area in the bin of its prio/color
+// return FALSE if obj is drawn alone (mariner, highlight, NODTA, no AC() or more than one)
+{
+    return_if_null(batch);
+    return_if_null(obj);
+
+    S57_geo *geo = S52_PL_getGeo(obj);
+    if ((S57_AREAS_T!=S57_getObjtype(geo)) || (TRUE==S57_getGeoDyn(geo)) || (TRUE==S57_getHighlight(geo)))
+        return FALSE;
+
+    S52_Color *col    = NULL;
+    S52_CmdWrd cmdWrd = S52_PL_iniCmd(obj);
+    while (S52_CMD_NONE != cmdWrd) {
+        if (S52_CMD_ARE_CO == cmdWrd) {
+            if (NULL != col)
+                return FALSE;
+            col = S52_PL_getACdata(obj);
+        }
+        cmdWrd = S52_PL_getCmdNext(obj);
+    }
+    // Note: NODTA skipped in _renderAC()
+    if ((NULL==col) || (0==g_strcmp0(col->colName, "NODTA")))
+        return FALSE;
+
+    S57_prim *prim = S57_getPrimGeo(geo);
+    if (NULL == prim)
+        prim = _tessd(_tobj, geo);
+
+    guint     primNbr = 0;
+    vertex_t *vert    = NULL;
+    guint     vertNbr = 0;
+    guint     vboID   = 0;
+    if ((NULL==prim) || (FALSE==S57_getPrimData(prim, &primNbr, &vert, &vertNbr, &vboID)))
+        return FALSE;
+
+    for (guint i=0; i<primNbr; ++i) {
+        GLint mode  = 0;
+        GLint first = 0;
+        GLint count = 0;
+        S57_getPrimIdx(prim, i, &mode, &first, &count);
+        if ((GL_TRIANGLES!=mode) && (GL_TRIANGLE_STRIP!=mode) && (GL_TRIANGLE_FAN!=mode))
+            return FALSE;
+    }
+
+    // find bin
+    S52_disPrio prio    = S52_PL_getDPRI(obj);
+    S52_RadPrio radPrio = S52_PL_getRPRI(obj);
+    _ACbin     *bin     = NULL;
+    for (guint i=0; i<batch->bins->len; ++i) {
+        _ACbin *b = (_ACbin *)g_ptr_array_index(batch->bins, i);
+        if ((prio==b->prio) && (radPrio==b->radPrio) && (col->fragAtt.cidx==b->cidx) && (col->fragAtt.trans==b->trans)) {
+            bin = b;
+            break;
+        }
+    }
+    if (NULL == bin) {
+        bin          = g_new0(_ACbin, 1);
+        bin->prio    = prio;
+        bin->radPrio = radPrio;
+        bin->cidx    = col->fragAtt.cidx;
+        bin->trans   = col->fragAtt.trans;
+        bin->vertex  = g_array_new(FALSE, FALSE, sizeof(vertex_t)*3);
+        bin->range   = g_array_new(FALSE, FALSE, sizeof(_ACrange));
+        g_ptr_array_add(batch->bins, bin);
+    }
+
+    // strip / fan to triangles
+    _ACrange r = {obj, bin->vertex->len, 0, 0};
+    for (guint i=0; i<primNbr; ++i) {
+        GLint mode  = 0;
+        GLint first = 0;
+        GLint count = 0;
+        S57_getPrimIdx(prim, i, &mode, &first, &count);
+
+        switch (mode) {
+            case GL_TRIANGLES:
+                g_array_append_vals(bin->vertex, vert + first*3, count);
+                r.count += count;
+                break;
+            case GL_TRIANGLE_STRIP:
+                for (GLint j=2; j<count; ++j) {
+                    if (0 == j%2)
+                        r.count += _ACbatchAddTri(bin->vertex, vert, first+j-2, first+j-1, first+j);
+                    else
+                        r.count += _ACbatchAddTri(bin->vertex, vert, first+j-1, first+j-2, first+j);
+                }
+                break;
+            case GL_TRIANGLE_FAN:
+                for (GLint j=2; j<count; ++j)
+                    r.count += _ACbatchAddTri(bin->vertex, vert, first, first+j-1, first+j);
+                break;
+        }
+    }
+    g_array_append_val(bin->range, r);
+
+    return TRUE;
+}
+
+int        S52_GL_endACbatch(S52_GL_ACbatch *batch)
+// upload all bins in one VBO
+{
+    return_if_null(batch);
+
+    GLint nVert = 0;
+    for (guint i=0; i<batch->bins->len; ++i) {
+        _ACbin *bin = (_ACbin *)g_ptr_array_index(batch->bins, i);
+        bin->first  = nVert;
+        nVert      += bin->vertex->len;
+    }
+    if (0 == nVert)
+        return FALSE;
+
+    glGenBuffers(1, &batch->vboID);
+    if (0 == batch->vboID) {
+        PRINTF("ERROR: glGenBuffers() fail\n");
+        g_assert(0);
+        return FALSE;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, batch->vboID);
+    glBufferData(GL_ARRAY_BUFFER, nVert*sizeof(vertex_t)*3, NULL, GL_STATIC_DRAW);
+
+    for (guint i=0; i<batch->bins->len; ++i) {
+        _ACbin *bin = (_ACbin *)g_ptr_array_index(batch->bins, i);
+
+        glBufferSubData(GL_ARRAY_BUFFER, bin->first*sizeof(vertex_t)*3, bin->vertex->len*sizeof(vertex_t)*3, bin->vertex->data);
+        g_array_free(bin->vertex, TRUE);
+        bin->vertex = NULL;
+
+        // Note: range array is final - ref to its element are stable
+        for (guint j=0; j<bin->range->len; ++j) {
+            _ACrange *r = &g_array_index(bin->range, _ACrange, j);
+            r->first += bin->first;
+            g_hash_table_insert(batch->objRange, r->obj, r);
+        }
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    _checkError("S52_GL_endACbatch()");
+
+    return TRUE;
+}
+
+int        S52_GL_delACbatch(S52_GL_ACbatch *batch)
+{
+    return_if_null(batch);
+
+    if (batch == _acBatchCrnt)
+        _acBatchCrnt = NULL;
+
+    if (0 != batch->vboID)
+        glDeleteBuffers(1, &batch->vboID);
+
+    for (guint i=0; i<batch->bins->len; ++i) {
+        _ACbin *bin = (_ACbin *)g_ptr_array_index(batch->bins, i);
+        if (NULL != bin->vertex)
+            g_array_free(bin->vertex, TRUE);
+        g_array_free(bin->range, TRUE);
+        g_free(bin);
+    }
+    g_ptr_array_free(batch->bins, TRUE);
+    g_hash_table_destroy(batch->objRange);
+
+    g_free(batch);
+
+    return TRUE;
+}
+
+int        S52_GL_drawACbatch(S52_GL_ACbatch *batch, GPtrArray *journal, guint beg, guint end)
+// stamp obj of journal[beg, end[ that are in batch then draw
+// consecutive stamped range of each bin of this display priority in one call
+{
+    _acBatchCrnt = NULL;
+
+    if ((NULL==batch) || (0==batch->vboID) || (beg>=end) || (S52_GL_DRAW!=_crnt_GL_cycle))
+        return FALSE;
+
+    if (S52_CMD_WRD_FILTER_AC & (int) S52_MP_get(S52_CMD_WRD_FILTER))
+        return FALSE;
+
+    ++_acStamp;
+    guint n = 0;
+    for (guint i=beg; i<end; ++i) {
+        S52_obj  *obj = (S52_obj *)g_ptr_array_index(journal, i);
+        _ACrange *r   = (_ACrange *)g_hash_table_lookup(batch->objRange, obj);
+        // highlight is drawn alone
+        if ((NULL!=r) && (FALSE==S57_getHighlight(S52_PL_getGeo(obj)))) {
+            r->stamp = _acStamp;
+            ++n;
+        }
+    }
+    if (0 == n)
+        return FALSE;
+
+    S52_disPrio prio = S52_PL_getDPRI((S52_obj *)g_ptr_array_index(journal, beg));
+    int         pal  = (int) S52_MP_get(S52_MAR_COLOR_PALETTE);
+
+    _glUniformMatrix4fv_uModelview();
+
+    glBindBuffer(GL_ARRAY_BUFFER, batch->vboID);
+    glEnableVertexAttribArray(_aPosition);
+    glVertexAttribPointer(_aPosition, 3, GL_FLOAT, GL_FALSE, 0, 0);
+
+    for (guint i=0; i<batch->bins->len; ++i) {
+        _ACbin *bin = (_ACbin *)g_ptr_array_index(batch->bins, i);
+        if (prio != bin->prio)
+            continue;
+
+        // color from the palette in use - no rebuild on palette change
+        S52_Color *pcol = S52_PL_getPalColor(pal, bin->cidx);
+        if (NULL == pcol)
+            continue;
+        S52_Color col = *pcol;
+        col.fragAtt.trans = bin->trans;
+
+        int     colSet = FALSE;
+        GLint   first  = 0;
+        GLsizei count  = 0;
+        for (guint j=0; j<=bin->range->len; ++j) {
+            _ACrange *r = (j<bin->range->len) ? &g_array_index(bin->range, _ACrange, j) : NULL;
+            if ((NULL!=r) && (_acStamp!=r->stamp))
+                continue;
+
+            // extend run
+            if ((NULL!=r) && (0<count) && (first+count==r->first)) {
+                count += r->count;
+                continue;
+            }
+
+            if (0 < count) {
+                if (FALSE == colSet) {
+                    _setFragAttrib(&col, FALSE);
+                    colSet = TRUE;
+                }
+                glDrawArrays(GL_TRIANGLES, first, count);
+            }
+
+            if (NULL != r) {
+                first = r->first;
+                count = r->count;
+            }
+        }
     }
 
+    glDisableVertexAttribArray(_aPosition);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    _acBatchCrnt = batch;
+
+    _checkError("S52_GL_drawACbatch()");
+
     return TRUE;
 }
+#endif  // S52_USE_AC_BATCH
 
 int        S52_GL_drawBlit(double scale_x, double scale_y, double scale_z, double north)
 {
@@ -6242,6 +7458,7 @@ static int       _drawFBPixels(void)
     return TRUE;
 }
 
+#ifndef S52_USE_PICK_GEO
 static int       _pickFBPixels(S52_obj *obj)
 {
     // Note: Nexus/Adreno ReadPixels must be POT, hence 8 x 8 extent
@@ -6303,6 +7520,7 @@ static int       _pickFBPixels(S52_obj *obj)
 
     return TRUE;
 }
+#endif  // !S52_USE_PICK_GEO
 
 static int       _doProjection(vp_t vp, double centerLat, double centerLon, double rangeDeg)
 // WARNING: need final viewport
@@ -6393,6 +7611,12 @@ int        S52_GL_begin(S52_GL_cycle cycle)
 
     S52_GL_init();
 
+#ifdef S52_USE_CENTROID_BG
+    // pickup centroids computed since last frame
+    if (S52_GL_DRAW == cycle)
+        _cenCollect();
+#endif
+
     // debug
     _drgare = 0;
     _depare = 0;
@@ -6406,6 +7630,18 @@ int        S52_GL_begin(S52_GL_cycle cycle)
     _nCall     = 0;
     _npoly     = 0;
 
+#ifdef S52_USE_FRAME_STATS
+    _nobj      = 0;
+    _ncmd      = 0;
+    _oclip     = 0;
+    _nDrawCall = 0;
+    _nVertex   = 0;
+#if defined(S52_USE_GL2) && !defined(S52_USE_GLSC2)
+    if (S52_GL_DRAW==cycle || S52_GL_LAST==cycle)
+        _gpuTimerBeg((S52_GL_DRAW==cycle) ? 0 : 1);
+#endif
+#endif
+
     // test optimisation
     //_identity_MODELVIEW     = FALSE;
     //_identity_MODELVIEW_cnt = 0;
@@ -6498,6 +7734,10 @@ int        S52_GL_begin(S52_GL_cycle cycle)
 
     glActiveTexture(GL_TEXTURE0);  // default
     glUniform1i(_uSampler2d0, 0);  // default
+#ifdef S52_USE_PAL_IDX
+    // palettes on unit 1 - select palette of this frame
+    _palTexUpdate();
+#endif
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
 
@@ -6548,6 +7788,10 @@ int        S52_GL_begin(S52_GL_cycle cycle)
         //memset(_pixelsRead, 0, sizeof(_pixelsRead));
 
         g_ptr_array_set_size(_objPick, 0);
+#ifdef S52_USE_PICK_GEO
+        g_array_set_size(_objPickCol, 0);
+        _pickVP = _vp;
+#endif
 
         // make sure that _cIdx.color are not messed up
         //glDisable(GL_POINT_SMOOTH);
@@ -6648,10 +7892,26 @@ int        S52_GL_end(S52_GL_cycle cycle)
         return FALSE;
     }
 
+#ifdef S52_USE_SY_INST
+    // draw leftover, forget symbol definition (PLib can change between cycle)
+    if (S52_GL_DRAW == cycle) {
+        _SYinstFlush();
+        _SYinstReset();
+    }
+#endif
+
+#ifdef S52_USE_TXT_BATCH
+    if (S52_GL_DRAW == cycle)
+        _TXTbatchFlush();
+#endif
+
     switch(_crnt_GL_cycle) {
         // optimisation: pick case 1, read pixels once at the end of the pick cycle
         //case S52_GL_PICK: _pickFBPixels(NULL); _glMatrixDel(VP_PRJ); break;
     case S52_GL_PICK: //_fb_pixels_udp=TRUE;  // FIXME: is this needed
+#ifdef S52_USE_PICK_GEO
+                          _pickFBPixelsOnce();
+#endif
                           glViewport(_vp.x, _vp.y, _vp.w, _vp.h);
                           _glMatrixDel(VP_PRJ);
                           break;
@@ -6728,6 +7988,28 @@ int        S52_GL_end(S52_GL_cycle cycle)
 #endif
 #endif  // GL2
 
+#ifdef S52_USE_FRAME_STATS
+    if (S52_GL_DRAW==_crnt_GL_cycle || S52_GL_LAST==_crnt_GL_cycle) {
+        int i = (S52_GL_DRAW==_crnt_GL_cycle) ? 0 : 1;
+
+        _stat[i].nobj      = _nobj;
+        _stat[i].ncmd      = _ncmd;
+        _stat[i].oclip     = _oclip;
+        _stat[i].nDrawCall = _nDrawCall;
+        _stat[i].nVertex   = _nVertex;
+        _stat[i].nTris     = _ntris;
+        _stat[i].nTriStrip = _ntristrip;
+        _stat[i].nTriFan   = _ntrisfan;
+        _stat[i].nFrag     = _nFrag;
+#if defined(S52_USE_GL2) && !defined(S52_USE_GLSC2)
+        _gpuTimerEnd(i);
+        _stat[i].gpuMsec   = _gpuMsec[i];
+#else
+        _stat[i].gpuMsec   = -1.0;
+#endif
+    }
+#endif
+
     _checkError("S52_GL_end() -fini-");
 
     _crnt_GL_cycle = S52_GL_NONE;
@@ -6735,6 +8017,22 @@ int        S52_GL_end(S52_GL_cycle cycle)
     return TRUE;
 }
 
+#ifdef S52_USE_FRAME_STATS
+int        S52_GL_getStat(S52_GL_cycle cycle, S52_GL_stat *stat)
+{
+    return_if_null(stat);
+
+    if (S52_GL_DRAW!=cycle && S52_GL_LAST!=cycle) {
+        PRINTF("WARNING: no stat for this cycle (%i)\n", cycle);
+        return FALSE;
+    }
+
+    *stat = _stat[(S52_GL_DRAW==cycle) ? 0 : 1];
+
+    return TRUE;
+}
+#endif
+
 int        S52_GL_delDL(S52_obj *obj)
 // delete the GL part of S57 geo object (Display List)
 // S52_obj is use only by FREETYPE_GL
@@ -6742,11 +8040,33 @@ int        S52_GL_delDL(S52_obj *obj)
     S57_geo  *geo  = S52_PL_getGeo(obj);
     S57_prim *prim = S57_getPrimGeo(geo);
 
+#ifdef S52_USE_LC_CACHE
+    if (NULL != _LCcacheTbl)
+        g_hash_table_remove(_LCcacheTbl, obj);
+#endif
+
+#ifdef S52_USE_CENTROID_BG
+    // result of a job in the worker will be dropped
+    if (NULL != _cenTbl)
+        g_hash_table_remove(_cenTbl, geo);
+#endif
+
 #ifdef S52_USE_GLSC1
     // SC can't delete a display list --no garbage collector
     return TRUE;
 #endif
 
+#if defined(S52_USE_GL2) && defined(S52_USE_OPENGL_VBO) && !defined(S52_USE_GLSC2)
+    // LS() VBO
+    {
+        guint lineVBO = S57_getLineVBO(geo, NULL);
+        if (0 != lineVBO) {
+            glDeleteBuffers(1, &lineVBO);
+            S57_setLineVBO(geo, 0);
+        }
+    }
+#endif
+
     // S57 have Display List / VBO
     if (NULL != prim) {
         guint     primNbr = 0;
@@ -6785,6 +8105,10 @@ int        S52_GL_delDL(S52_obj *obj)
                         guint vboID = S52_PL_getFreetypeGL_VBO(obj, &len, &dummy, &dummy, &dum, &dum);
                         if (GL_TRUE == glIsBuffer(vboID)) {
                             glDeleteBuffers(1, &vboID);
+#ifdef S52_USE_TXT_BATCH
+                            if (NULL != _txtGlyph)
+                                g_hash_table_remove(_txtGlyph, GUINT_TO_POINTER(vboID));
+#endif
 
                             S52_PL_setFreetypeGL_VBO(obj, 0, 0, 0.0, 0.0);
                         }
@@ -7081,6 +8405,22 @@ static int       _validateGLcontext(void)
             _GL_KHR_no_error = (NULL== str)? FALSE : TRUE;
         }
 
+#ifdef S52_USE_SY_INST
+        {   // GL_EXT_instanced_arrays / GL_ANGLE_instanced_arrays - SY() instancing
+            const char *str = g_strrstr((const char *)extensions, "_instanced_arrays");
+            PRINTF("DEBUG: GL_EXT/ANGLE_instanced_arrays %s\n", (NULL==str)? "FAILED": "OK");
+            _GL_EXT_instanced_arrays = (NULL== str)? FALSE : TRUE;
+        }
+#endif
+
+#if defined(S52_USE_FRAME_STATS) && !defined(S52_USE_GLSC2)
+        {   // GL_EXT_disjoint_timer_query - GPU time
+            const char *str = g_strrstr((const char *)extensions, "GL_EXT_disjoint_timer_query");
+            PRINTF("DEBUG: GL_EXT_disjoint_timer_query %s\n", (NULL==str)? "FAILED": "OK");
+            _GL_EXT_disjoint_timer_query = (NULL== str)? FALSE : TRUE;
+        }
+#endif
+
 #endif  // S52_USE_GL2
 
     }
@@ -7135,6 +8475,10 @@ int        S52_GL_init(void)
 
     if (NULL == _objPick)
         _objPick = g_ptr_array_new();
+#ifdef S52_USE_PICK_GEO
+    if (NULL == _objPickCol)
+        _objPickCol = g_array_new(FALSE, FALSE, sizeof(GLubyte));
+#endif
 
     //_DEBUG = TRUE;
 
@@ -7222,6 +8566,11 @@ int        S52_GL_done(void)
     if (TRUE == _doInit)
         return FALSE;
 
+#ifdef S52_USE_CENTROID_BG
+    // stop the worker before _tcen / _tcin are freed
+    _cenDoneAll();
+#endif
+
     _freeGLU();
 
     // g_clear() !
@@ -7236,12 +8585,27 @@ int        S52_GL_done(void)
         g_ptr_array_free(_objPick, TRUE);
         _objPick = NULL;
     }
+#ifdef S52_USE_PICK_GEO
+    if (NULL != _objPickCol) {
+        g_array_free(_objPickCol, TRUE);
+        _objPickCol = NULL;
+    }
+#endif
 
     if (NULL != _tmpWorkBuffer) {
         g_array_free(_tmpWorkBuffer, TRUE);
         _tmpWorkBuffer = NULL;
     }
 
+#if defined(S52_USE_FRAME_STATS) && defined(S52_USE_GL2) && !defined(S52_USE_GLSC2)
+    for (int i=0; i<2; ++i) {
+        if (0 != _gpuQuery[i]) {
+            _glDeleteQueriesEXT(1, &_gpuQuery[i]);
+            _gpuQuery[i] = 0;
+        }
+    }
+#endif
+
 #ifdef S52_USE_AFGLOW
     if (NULL != _aftglwColorArr) {
         g_array_free(_aftglwColorArr, TRUE);
@@ -7267,6 +8631,10 @@ int        S52_GL_done(void)
         g_array_free(_tessWorkBuf_f, TRUE);
         _tessWorkBuf_f = NULL;
     }
+    if (NULL != _lineWorkBuf_f) {
+        g_array_free(_lineWorkBuf_f, TRUE);
+        _lineWorkBuf_f = NULL;
+    }
 #endif
 
     // done texture object
@@ -7277,6 +8645,9 @@ int        S52_GL_done(void)
     glDeleteFramebuffers(1, &_fboID);
     glDeleteProgram(_programObject);
 #endif
+#ifdef S52_USE_AP_CACHE
+    _APtexCacheDone();
+#endif
 
     _dashpa_mask_texID = 0;
     _dottpa_mask_texID = 0;
@@ -7284,12 +8655,40 @@ int        S52_GL_done(void)
     _fboID             = 0;
     _programObject     = 0;
 
+#ifdef S52_USE_PAL_IDX
+#if !defined(S52_USE_GLSC2)
+    glDeleteTextures(1, &_palTexID);
+#endif
+    _palTexID          = 0;
+    _palStamp          = 0;
+#endif
+
+#ifdef S52_USE_SY_INST
+    _SYinstDone();
+#endif
+
+#ifdef S52_USE_LC_CACHE
+    if (NULL != _LCcacheTbl) {
+        g_hash_table_destroy(_LCcacheTbl);
+        _LCcacheTbl = NULL;
+    }
+#endif
+
+#ifdef S52_USE_TXT_BATCH
+    _TXTbatchDone();
+#endif
+
 
 #ifdef S52_USE_FREETYPE_GL
+#ifdef S52_USE_TXT_SDF
+    // one SDF font shared by all slot
+    texture_font_delete(_freetype_gl_font[0]);
+#else
     texture_font_delete(_freetype_gl_font[0]);
     texture_font_delete(_freetype_gl_font[1]);
     texture_font_delete(_freetype_gl_font[2]);
     texture_font_delete(_freetype_gl_font[3]);
+#endif
     _freetype_gl_font[0] = NULL;
     _freetype_gl_font[1] = NULL;
     _freetype_gl_font[2] = NULL;
@@ -90,6 +90,47 @@ int   S52_GL_drawStrWin(double pixels_x, double pixels_y, const char *colorName,
 // done frame, restore OpenGL state
 int   S52_GL_end(S52_GL_cycle cycle);
 
+#ifdef S52_USE_FRAME_STATS
+// statistic of the last S52_GL_DRAW / S52_GL_LAST cycle
+typedef struct S52_GL_stat {
+    guint  nobj;       // object drawn
+    guint  ncmd;       // command word drawn
+    guint  oclip;      // object clipped
+    guint  nDrawCall;  // glDrawArrays() call
+    guint  nVertex;    // vertex drawn
+    guint  nTris;      // area triangle drawn as GL_TRIANGLES
+    guint  nTriStrip;  // area GL_TRIANGLE_STRIP drawn
+    guint  nTriFan;    // area GL_TRIANGLE_FAN drawn
+    guint  nFrag;      // fragment attribute set (color switch)
+    double gpuMsec;    // GPU time of the last cycle completed, -1.0 if no timer query
+} S52_GL_stat;
+int   S52_GL_getStat(S52_GL_cycle cycle, S52_GL_stat *stat);
+#endif
+
+#ifdef S52_USE_TXT_BATCH
+// draw static text queued by S52_GL_drawText() since last call (S52_GL_DRAW cycle), one call per color
+int   S52_GL_flushTXT(void);
+#endif
+
+#ifdef S52_USE_SY_INST
+// draw point symbol queued since last call (S52_GL_DRAW cycle), one call per symbol primitive
+int   S52_GL_flushSY(void);
+#endif
+
+#ifdef S52_USE_AC_BATCH
+// AC() of static area merged per cell, display priority, radar priority and color
+typedef struct _S52_GL_ACbatch S52_GL_ACbatch;
+S52_GL_ACbatch *S52_GL_newACbatch(void);
+// add obj to batch, FALSE if obj is not batchable (drawn alone)
+int   S52_GL_addACbatch(S52_GL_ACbatch *batch, S52_obj *obj);
+// upload batch to GPU
+int   S52_GL_endACbatch(S52_GL_ACbatch *batch);
+int   S52_GL_delACbatch(S52_GL_ACbatch *batch);
+// draw AC() of obj in journal[beg, end[ (same display priority), S52_GL_draw() then skip it
+// Note: batch NULL reset at the end of the journal
+int   S52_GL_drawACbatch(S52_GL_ACbatch *batch, GPtrArray *journal, guint beg, guint end);
+#endif
+
 // debug
 int   S52_GL_dumpS57IDPixels(const char *toFilename, S52_obj *obj, unsigned int width, unsigned int height);
 
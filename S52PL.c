@@ -30,6 +30,7 @@
 
 #include <glib.h>
 #include <math.h>           // INFINITY
+#include <stdlib.h>         // atoi(), qsort()
 
 
 #define S52_COL_NUM   63    // number of color (#64 is transparent)
@@ -65,6 +66,7 @@ typedef struct _colTable {
 
 static GArray *_colTables = NULL;
 static GTree  *_colref    = NULL;  // fast indexing of color array
+static guint   _colStamp  = 1;     // change each time a color table change (GPU palette reload)
 
 typedef enum _colorTableStat {
     _COL_TBL_NOSTAT =  0 , 	// unknown color table status
@@ -254,6 +256,27 @@ typedef struct _prios {
                                 // hense 'int', but its a string in the specs)
 } _prios;
 
+#ifdef S52_USE_LUP_COMPILE
+// ATTC compiled in S52_PL_load() - see _compileLUP()
+typedef enum _LUPattT {
+    LUP_ATT_ANY = 0,            // ATTL only, any value but unknown [S52-A-2:8.3.3.4(i)]
+    LUP_ATT_UNK,                // ATTL?, value unknown             [S52-A-2:8.3.3.4(ii)]
+    LUP_ATT_VAL                 // ATTL + ATTV
+} _LUPattT;
+
+typedef struct _LUPatt {
+    GQuark       attl;          // attribute name interned
+    _LUPattT     type;
+    int          val;           // atoi(attv)
+    const char  *attv;          // attribute value - ref in ATTC
+} _LUPatt;
+
+typedef struct _LUPcand {
+    struct _LUP *LUP;           // LUP with an ATTC
+    guint        rank;          // order in the OBCL chain
+} _LUPcand;
+#endif  // S52_USE_LUP_COMPILE
+
 typedef struct _LUP {
     int          RCID;          // record identifier
     char         OBCL[S52_LUP_NMLN+1]; // LUP name --'\0' terminated
@@ -267,6 +290,13 @@ typedef struct _LUP {
     // ---- not a S52 fields ------------------------------------
     S52_objSupp  supp;      // suppress display of this object type
     struct _LUP *OBCLnext;  // next LUP with name OBCL
+
+#ifdef S52_USE_LUP_COMPILE
+    guint        nAtt;      // ATTC compiled
+    _LUPatt     *att;
+    guint        nCand;     // top LUP only: candidate of this OBCL ordered by nAtt (max match)
+    _LUPcand    *cand;
+#endif
 } _LUP;
 
 typedef enum _poly_mode {
@@ -462,6 +492,22 @@ static const char *natsur[] = {
 //static GPtrArray    *_objList = NULL;
 static GHashTable    *_objHash = NULL;
 
+#ifdef S52_USE_THREAD_LOAD
+// S52_obj are created by the cell loading workers
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex   _objHash_mutex = G_STATIC_MUTEX_INIT;
+#define OBJHASH_LOCK    g_static_mutex_lock  (&_objHash_mutex)
+#define OBJHASH_UNLOCK  g_static_mutex_unlock(&_objHash_mutex)
+#else
+static GMutex         _objHash_mutex;
+#define OBJHASH_LOCK    g_mutex_lock  (&_objHash_mutex)
+#define OBJHASH_UNLOCK  g_mutex_unlock(&_objHash_mutex)
+#endif
+#else
+#define OBJHASH_LOCK
+#define OBJHASH_UNLOCK
+#endif
+
 
 
 //------------------------
@@ -664,6 +710,11 @@ static void       _delLUP(gpointer value)
        if (NULL != LUP->ATTC) g_string_free(LUP->ATTC, TRUE);
        if (NULL != LUP->INST) g_string_free(LUP->INST, TRUE);
 
+#ifdef S52_USE_LUP_COMPILE
+       g_free(LUP->att);
+       g_free(LUP->cand);
+#endif
+
        g_free(LUP);
 
        LUP = crntLUP;
@@ -715,6 +766,74 @@ static int        _dumpATT(char *str)
     return TRUE;
 }
 
+#ifdef S52_USE_LUP_COMPILE
+static int        _matchATT(_LUP *LUP, S57_geo *geo)
+// return the number of attribute match of this LUP
+// Note: same result as the ATTC scan in _lookUpLUP()
+{
+    int nATTmatch = 0;
+
+    for (guint i=0; i<LUP->nAtt; ++i) {
+        _LUPatt *att  = &LUP->att[i];
+        GString *attv = S57_getAttValQ(geo, att->attl);
+
+        // no att value - no match
+        if (NULL == attv)
+            return 0;
+
+        gboolean unknown = (0 == g_strcmp0(attv->str, EMPTY_NUMBER_MARKER));
+
+        if ((LUP_ATT_ANY==att->type) && (FALSE==unknown)) {
+            ++nATTmatch;
+            continue;
+        }
+
+#ifndef S52_USE_CA_ENC
+        if ((LUP_ATT_UNK==att->type) && (TRUE==unknown)) {
+            ++nATTmatch;
+            continue;
+        }
+#endif
+
+        // value check - skip this LUP (but keep match so far)
+        if (NULL == strstr(attv->str, att->attv))
+            return nATTmatch;
+
+        if (atoi(attv->str) == att->val)
+            ++nATTmatch;
+    }
+
+    return nATTmatch;
+}
+
+static _LUP      *_matchLUP(_LUP *LUPtop, S57_geo *geo)
+// Get the LUP with maximum Object attribute match - first one in the chain on tie
+{
+    _LUP  *bestLUP        = LUPtop;
+    int    best_nATTmatch = 0;
+    guint  best_rank      = G_MAXUINT;
+
+    for (guint i=0; i<LUPtop->nCand; ++i) {
+        _LUPcand *cand = &LUPtop->cand[i];
+
+        // candidate ordered by nAtt - no better match possible
+        if ((int)cand->LUP->nAtt < best_nATTmatch)
+            break;
+
+        int nATTmatch = _matchATT(cand->LUP, geo);
+        if ((0 != nATTmatch) &&
+            ((nATTmatch > best_nATTmatch) || (nATTmatch==best_nATTmatch && cand->rank<best_rank)))
+        {
+            best_nATTmatch = nATTmatch;
+            best_rank      = cand->rank;
+            bestLUP        = cand->LUP;
+        }
+    }
+
+    return bestLUP;
+}
+#endif  // S52_USE_LUP_COMPILE
+
 static _LUP      *_lookUpLUP(_LUP *LUPlist, S57_geo *geo)
 // Get the LUP with maximum Object attribute match.
 //
@@ -766,6 +885,11 @@ static _LUP      *_lookUpLUP(_LUP *LUPlist, S57_geo *geo)
         }
     }
 
+#ifdef S52_USE_LUP_COMPILE
+    if (NULL != bestLUP->cand)
+        return _matchLUP(bestLUP, geo);
+#endif
+
     // Get next LUP - the first one is alway empty.
     LUPlist = LUPlist->OBCLnext;
 
@@ -1132,7 +1256,11 @@ static int        _resolveSMB(_S52_obj *obj, int alt)
     // expand CS
     S52_CS_cb CScb = cmd->cmd.CS->CScb;
     if (NULL != CScb) {
+#if defined(S52_USE_CS_MP_DEP) && defined(S52_DEBUG)
+        obj->CSinst[alt] = S52_CS_checkMP(cmd->cmd.CS, obj->geo);
+#else
         obj->CSinst[alt] = CScb(obj->geo);
+#endif
         if (NULL!=obj->CSinst[alt] && 0!=obj->CSinst[alt]->len) {
             obj->CScmdL[alt] = _parseINST(obj->CSinst[alt], &obj->hasText[alt]);
             _cmdWL *CScmdL   = obj->CScmdL[alt];
@@ -1581,6 +1709,7 @@ static int        _flushColors()
             ct->tableName = NULL;
         }
         g_array_set_size(_colTables, 0);
+        ++_colStamp;
     } else {
         PRINTF("WARNING: trying to deleted PL Color Table twice!\n");
         g_assert(0);
@@ -1628,6 +1757,7 @@ static int        _parseCOLS(_PL *fp)
     }
 
     _readColor(fp, pct->colors);
+    ++_colStamp;
 
     // make sure the new table is full
     if (pct->colors->len != (guint) g_tree_nnodes(_colref)) {
@@ -1992,6 +2122,108 @@ static int        _initPLtables()
     return TRUE;
 }
 
+#ifdef S52_USE_LUP_COMPILE
+static int        _compileATTC(_LUP *LUP)
+// intern attribute name and parse value of ATTC
+// Note: ATTC chopped at US (abc\0def\0\0)
+{
+    g_free(LUP->att);
+    LUP->att  = NULL;
+    LUP->nAtt = 0;
+
+    if (NULL == LUP->ATTC)
+        return FALSE;
+
+    for (char *attLV=LUP->ATTC->str; '\0'!=*attLV; attLV+=strlen(attLV)+1)
+        ++LUP->nAtt;
+
+    LUP->att = g_new0(_LUPatt, LUP->nAtt);
+
+    guint i = 0;
+    for (char *attLV=LUP->ATTC->str; '\0'!=*attLV; attLV+=strlen(attLV)+1, ++i) {
+        char attl[7] = {'\0'};
+        memcpy(attl, attLV, 6);
+
+        _LUPatt *att = &LUP->att[i];
+        att->attl = g_quark_from_string(attl);
+        att->attv = attLV + 6;
+        att->val  = atoi(att->attv);
+        att->type = ('\0' == attLV[6]) ? LUP_ATT_ANY :
+                    ('?'  == attLV[6]) ? LUP_ATT_UNK :
+                                         LUP_ATT_VAL ;
+    }
+
+    return TRUE;
+}
+
+static int        _cmpCand(gconstpointer a, gconstpointer b)
+// more attribute first then PLib order
+{
+    const _LUPcand *A = (const _LUPcand *)a;
+    const _LUPcand *B = (const _LUPcand *)b;
+
+    if (A->LUP->nAtt != B->LUP->nAtt)
+        return (A->LUP->nAtt > B->LUP->nAtt) ? -1 : 1;
+
+    return (A->rank < B->rank) ? -1 : (A->rank > B->rank) ? 1 : 0;
+}
+
+static gboolean   _compileLUP(gpointer key, gpointer value, gpointer data)
+// build candidate list of this OBCL
+{
+    (void)key;
+
+    _LUP  *LUPtop = (_LUP*) value;
+    guint *nOBCL  = (guint*) data;
+
+    g_free(LUPtop->cand);
+    LUPtop->cand  = NULL;
+    LUPtop->nCand = 0;
+
+    // Note: the top LUP is never a candidate [S52-A-2:8.3.3.2]
+    guint n = 0;
+    for (_LUP *LUP=LUPtop->OBCLnext; NULL!=LUP; LUP=LUP->OBCLnext) {
+        if (TRUE == _compileATTC(LUP))
+            ++n;
+    }
+    if (0 == n)
+        return FALSE;
+
+    LUPtop->cand = g_new(_LUPcand, n);
+    guint rank = 0;
+    for (_LUP *LUP=LUPtop->OBCLnext; NULL!=LUP; LUP=LUP->OBCLnext, ++rank) {
+        if (NULL != LUP->ATTC) {
+            LUPtop->cand[LUPtop->nCand].LUP  = LUP;
+            LUPtop->cand[LUPtop->nCand].rank = rank;
+            ++LUPtop->nCand;
+        }
+    }
+    qsort(LUPtop->cand, LUPtop->nCand, sizeof(_LUPcand), _cmpCand);
+
+    ++(*nOBCL);
+
+    return FALSE;  // continue
+}
+
+static int        _compileLUPall(void)
+// (re)compile all LUP - a PLib can replace LUP of a previous one
+{
+    guint   nOBCL = 0;
+    GTimer *timer = g_timer_new();
+
+    g_tree_foreach(_selLUP(_LUP_LINES), _compileLUP, &nOBCL);
+    g_tree_foreach(_selLUP(_LUP_PLAIN), _compileLUP, &nOBCL);
+    g_tree_foreach(_selLUP(_LUP_SYMBO), _compileLUP, &nOBCL);
+    g_tree_foreach(_selLUP(_LUP_SIMPL), _compileLUP, &nOBCL);
+    g_tree_foreach(_selLUP(_LUP_PAPER), _compileLUP, &nOBCL);
+
+    PRINTF("NOTE: LUP compiled for %i OBCL (%.3f msec)\n", nOBCL, g_timer_elapsed(timer, NULL) * 1000);
+    g_timer_destroy(timer);
+
+    return TRUE;
+}
+#endif  // S52_USE_LUP_COMPILE
+
 static int        _loadPL(_PL *fp)
 {
 
@@ -2676,6 +2908,11 @@ int         S52_PL_init(void)
         */
     }
 
+#ifdef S52_USE_LUP_COMPILE
+    // built-in PLib
+    _compileLUPall();
+#endif
+
     _loadCondSymb();
 
     //_objList = g_ptr_array_new();
@@ -2718,6 +2955,10 @@ int         S52_PL_load(const char *PLib)
 
         _loadPL(&pl);
 
+#ifdef S52_USE_LUP_COMPILE
+        _compileLUPall();
+#endif
+
         //g_mapped_file_free(mf);
         g_mapped_file_unref(mf);
     }
@@ -2952,7 +3193,10 @@ S52_obj    *S52_PL_newObj(S57_geo *geo)
             g_assert(0);
     }
     */
-    if (NULL != (obj = g_hash_table_lookup(_objHash, GINT_TO_POINTER(idx)))) {
+    OBJHASH_LOCK;
+    obj = (S52_obj *)g_hash_table_lookup(_objHash, GINT_TO_POINTER(idx));
+    OBJHASH_UNLOCK;
+    if (NULL != obj) {
         S52_PL_delObj(obj, FALSE);
     } else {
         obj = g_new0(S52_obj, 1);
@@ -3000,7 +3244,9 @@ S52_obj    *S52_PL_newObj(S57_geo *geo)
     // FIX: parse alternate first so that normal LUP reference will be the default
     _linkLUP(obj, 0);
 
+    OBJHASH_LOCK;
     g_hash_table_insert(_objHash, GINT_TO_POINTER(idx), obj);
+    OBJHASH_UNLOCK;
 
     return obj;
 }
@@ -3069,7 +3315,9 @@ S57_geo    *S52_PL_delObj(_S52_obj *obj, gboolean nilAuxInfo)
     // Note: that Aux Info is not touched - still in 'obj'
     //
 
+    OBJHASH_LOCK;
     S52_obj *objFree = (S52_obj *)g_hash_table_lookup(_objHash, GINT_TO_POINTER(S57_getS57ID(obj->geo)));
+    OBJHASH_UNLOCK;
     if (NULL == objFree) {
         PRINTF("DEBUG: should not be NULL (%u)\n", S57_getS57ID(obj->geo));
         g_assert(0);
@@ -3090,7 +3338,9 @@ S57_geo    *S52_PL_delObj(_S52_obj *obj, gboolean nilAuxInfo)
         obj->auxInfo.prevLeg = NULL;
         //obj->auxInfo.wholin  = NULL;
 
+        OBJHASH_LOCK;
         g_hash_table_remove(_objHash, GINT_TO_POINTER(S57_getS57ID(obj->geo)));
+        OBJHASH_UNLOCK;
     }
 
     //return geo;
@@ -3789,6 +4039,17 @@ guint       S52_PL_getAPtexID(_S52_obj *obj)
 
     return cmd->cmd.def->mask_texID;
 }
+
+const char *S52_PL_getAPname(_S52_obj *obj)
+{
+    return_if_null(obj);
+
+    _cmdWL *cmd = _getCrntCmd(obj);
+    if ((NULL==cmd) || (NULL==cmd->cmd.def))
+        return NULL;
+
+    return cmd->cmd.def->name.PANM;
+}
 #endif  // S52_USE_GL2 | S52_USE_GLES2
 
 gint        S52_PL_traverse(S52_SMBtblName tableNm, GTraverseFunc callBack)
@@ -4353,6 +4614,21 @@ const char *S52_PL_getText(_S52_obj *obj, S52_Color **col,
     return cmd->cmd.text->frmtd->str;
 }
 
+#ifdef S52_USE_CS_MP_DEP
+const char *S52_PL_getCSnm(_S52_obj *obj, int alt)
+{
+    return_if_null(obj);
+
+    // there can only be one CS (CND_SY) per LUP
+    for (_cmdWL *cmd=obj->cmdLorig[alt]; NULL!=cmd; cmd=cmd->next) {
+        if (S52_CMD_CND_SY == cmd->cmdWord)
+            return cmd->cmd.CS->name;
+    }
+
+    return NULL;
+}
+#endif  // S52_USE_CS_MP_DEP
+
 int         S52_PL_resetParseText(_S52_obj *obj)
 {
     return_if_null(obj);
@@ -4698,6 +4974,8 @@ int         S52_PL_setRGB(const char *colorName, unsigned char  R, unsigned char
     c->G = G;
     c->B = B;
 
+    ++_colStamp;
+
     return TRUE;
 }
 
@@ -4723,6 +5001,21 @@ guint       S52_PL_getPalTableSz()
     return _colTables->len;
 }
 
+S52_Color  *S52_PL_getPalColor(unsigned int palIdx, unsigned char colIdx)
+{
+    if ((NULL==_colTables) || (palIdx >= _colTables->len) || (colIdx >= S52_COL_NUM))
+        return NULL;
+
+    _colTable *ct = &g_array_index(_colTables, _colTable, palIdx);
+
+    return &g_array_index(ct->colors, S52_Color, colIdx);
+}
+
+guint       S52_PL_getPalStamp(void)
+{
+    return _colStamp;
+}
+
 const char *S52_PL_getPalTableNm(unsigned int idx)
 {
     if (NULL != _colTables) {
@@ -4916,3 +5209,113 @@ int main()
    return TRUE;
 }
 #endif
+
+#if defined(S52_MAIN_LUPBENCH) && defined(S52_USE_LUP_COMPILE)
+// micro-benchmark: _lookUpLUP() on one object per LUP of the built-in PLib (S52raz),
+// ATTC scan (before) then compiled LUP (after) - result must be the same LUP
+// $ gcc -std=gnu99 -O2 -DS52_USE_LUP_COMPILE -DS52_MAIN_LUPBENCH S52PL.c S52CS.c S52MP.c S57data.c S52utils.c
+//       `pkg-config --cflags --libs glib-2.0 lcms2` -lproj -lm
+#define LUPBENCH_NLAP 100
+
+typedef struct _benchObj {
+    _LUP    *LUPtop;
+    S57_geo *geo;
+} _benchObj;
+
+static gboolean   _benchAddLUP(gpointer key, gpointer value, gpointer data)
+// one object per LUP of this OBCL with the attributes of its ATTC
+{
+    (void)key;
+
+    _LUP   *LUPtop = (_LUP*) value;
+    GArray *objs   = (GArray*) data;
+
+    for (_LUP *LUP=LUPtop; NULL!=LUP; LUP=LUP->OBCLnext) {
+        _benchObj obj = {LUPtop, S57_setPOINT(g_new0(geocoord, 3))};
+        S57_setName(obj.geo, LUPtop->OBCL);
+
+        for (guint i=0; i<LUP->nAtt; ++i) {
+            _LUPatt *att = &LUP->att[i];
+            S57_setAtt(obj.geo, g_quark_to_string(att->attl),
+                       (LUP_ATT_ANY==att->type) ? "1"                 :
+                       (LUP_ATT_UNK==att->type) ? EMPTY_NUMBER_MARKER :
+                                                  att->attv           );
+        }
+
+        g_array_append_val(objs, obj);
+    }
+
+    return FALSE;  // continue
+}
+
+static double     _benchRun(GArray *objs, _LUP **res)
+{
+    GTimer *timer = g_timer_new();
+
+    for (int lap=0; lap<LUPBENCH_NLAP; ++lap) {
+        for (guint i=0; i<objs->len; ++i) {
+            _benchObj *obj = &g_array_index(objs, _benchObj, i);
+            res[i] = _lookUpLUP(obj->LUPtop, obj->geo);
+        }
+    }
+
+    double ms = g_timer_elapsed(timer, NULL) * 1000.0;
+    g_timer_destroy(timer);
+
+    return ms;
+}
+
+int main(int argc, char** argv)
+{
+    (void)argc;
+    (void)argv;
+
+    S52_PL_init();
+
+    GArray *objs = g_array_new(FALSE, FALSE, sizeof(_benchObj));
+    g_tree_foreach(_selLUP(_LUP_LINES), _benchAddLUP, objs);
+    g_tree_foreach(_selLUP(_LUP_PLAIN), _benchAddLUP, objs);
+    g_tree_foreach(_selLUP(_LUP_SYMBO), _benchAddLUP, objs);
+    g_tree_foreach(_selLUP(_LUP_SIMPL), _benchAddLUP, objs);
+    g_tree_foreach(_selLUP(_LUP_PAPER), _benchAddLUP, objs);
+
+    _LUP **resScan = g_new0(_LUP*, objs->len);
+    _LUP **resComp = g_new0(_LUP*, objs->len);
+
+    // before: hide the candidate list - _lookUpLUP() fall back to the ATTC scan
+    // Note: many obj share the same top LUP - save all first
+    _LUPcand **cand = g_new0(_LUPcand*, objs->len);
+    for (guint i=0; i<objs->len; ++i)
+        cand[i] = g_array_index(objs, _benchObj, i).LUPtop->cand;
+    for (guint i=0; i<objs->len; ++i)
+        g_array_index(objs, _benchObj, i).LUPtop->cand = NULL;
+    double msScan = _benchRun(objs, resScan);
+
+    // after: compiled
+    for (guint i=0; i<objs->len; ++i)
+        g_array_index(objs, _benchObj, i).LUPtop->cand = cand[i];
+    double msComp = _benchRun(objs, resComp);
+
+    guint nDiff = 0;
+    for (guint i=0; i<objs->len; ++i) {
+        if (resScan[i] != resComp[i])
+            ++nDiff;
+    }
+
+    guint nLookUp = objs->len * LUPBENCH_NLAP;
+    g_print("look-up:%u  scan:%10.3f msec (%.3f usec)  compiled:%10.3f msec (%.3f usec)  speed-up:%.2f  mismatch:%u\n",
+            nLookUp, msScan, msScan*1000.0/nLookUp, msComp, msComp*1000.0/nLookUp,
+            (0.0<msComp) ? msScan/msComp : 0.0, nDiff);
+
+    for (guint i=0; i<objs->len; ++i)
+        S57_doneData(g_array_index(objs, _benchObj, i).geo, NULL);
+    g_array_free(objs, TRUE);
+    g_free(cand);
+    g_free(resScan);
+    g_free(resComp);
+
+    S52_PL_done();
+
+    return (0 == nDiff) ? 0 : 1;
+}
+#endif  // S52_MAIN_LUPBENCH
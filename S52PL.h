@@ -276,6 +276,8 @@ int            S52_PL_getAPTilePos(S52_obj *obj, double *bbox_x, double *bbox_y,
 // store texture ID of patterns in GLES2
 int            S52_PL_setAPtexID(S52_obj *obj, guint mask_texID);
 guint          S52_PL_getAPtexID(S52_obj *obj);
+// pattern name (PANM) of the current AP() command
+const char    *S52_PL_getAPname (S52_obj *obj);
 #endif
 
 // traverse a symbology table calling 'callback' for each entree
@@ -302,6 +304,10 @@ int            S52_PL_hasText(S52_obj *obj);
 //int            S52_PL_hasLC(S52_obj *obj);
 // return CS name if this object has CS (Conditional Symbology) else NULL - not used (eventual optimisation)
 //const char    *S52_PL_hasCS(S52_obj *obj);
+#ifdef S52_USE_CS_MP_DEP
+// return CS name of the normal (0) or alternate (1) LUP of this object, else NULL
+const char    *S52_PL_getCSnm(S52_obj *obj, int alt);
+#endif
 
 // toggle display suppression of this class of object
 S52_objSupp    S52_PL_toggleObjClass(const char *className);
@@ -329,6 +335,10 @@ int            S52_PL_getRGB(const char *colorName, unsigned char *R, unsigned c
 
 guint          S52_PL_getPalTableSz(void);
 const char    *S52_PL_getPalTableNm(unsigned int idx);
+// color colIdx of palette palIdx, NULL if out of range (ie #64 TRANS)
+S52_Color     *S52_PL_getPalColor(unsigned int palIdx, unsigned char colIdx);
+// change when a color table is loaded or a color is set (S52_PL_setRGB())
+guint          S52_PL_getPalStamp(void);
 
 int            S52_PL_setNextLeg(S52_obj *obj, S52_obj *objNextLeg);
 S52_obj       *S52_PL_getNextLeg(S52_obj *obj);
@@ -61,6 +61,13 @@ if (NULL==ptr) {                             \
 
 #define CCHAR const char
 
+// thread-local: state private to a worker thread (loading cell, expanding CS)
+#if defined(S52_USE_THREAD_LOAD) || defined(S52_USE_THREAD_APP)
+#define S52_TLS __thread
+#else
+#define S52_TLS
+#endif
+
 
 // debug: valid label in .cfg file
 #define CFG_CATALOG  "CATALOG"
@@ -68,6 +75,7 @@ if (NULL==ptr) {                             \
 #define CFG_CHART    "CHART"
 #define CFG_WORLD    "WORLD"
 #define CFG_TTF      "TTF"
+#define CFG_CACHE    "CACHE"     // cell cache directory (S52_USE_CELL_CACHE)
 
 #define MAXL 1024    // MAX lenght of buffer _including_ '\0'
 typedef char valueBuf[MAXL];
@@ -26,6 +26,14 @@
 
 #include <math.h>       // INFINITY, nearbyint()
 
+// FIXME: for C99
+#ifndef M_PI
+#    define M_PI   3.14159265358979323846
+#endif
+#ifndef M_PI_2
+#    define M_PI_2 1.57079632679489661923
+#endif
+
 #ifdef S52_USE_PROJ
 static projPJ      _pjsrc   = NULL;   // projection source
 static projPJ      _pjdst   = NULL;   // projection destination
@@ -48,6 +56,45 @@ static const char *_argssrc = "+proj=latlong +ellps=WGS84 +datum=WGS84";
 
 // object's internal ID
 static unsigned int _S57ID = 1;  // start at 1, the number of object loaded
+#ifdef S52_USE_THREAD_LOAD
+// S57_geo are created by the cell loading workers
+#define S57_NEWID  ((unsigned int)g_atomic_int_add((volatile gint *)&_S57ID, 1))
+#else
+#define S57_NEWID  _S57ID++
+#endif
+
+#if defined(S52_USE_PROJ) && (defined(S52_USE_THREAD_LOAD) || defined(S52_USE_THREAD_PRJ))
+// PROJ4 object are shared - serialize pj_transform() call from the loading / projection workers
+#if (defined(S52_USE_ANDROID) || defined(_MINGW))
+static GStaticMutex _prj_mutex = G_STATIC_MUTEX_INIT;
+#define PRJ_LOCK    g_static_mutex_lock  (&_prj_mutex)
+#define PRJ_UNLOCK  g_static_mutex_unlock(&_prj_mutex)
+#else
+static GMutex       _prj_mutex;
+#define PRJ_LOCK    g_mutex_lock  (&_prj_mutex)
+#define PRJ_UNLOCK  g_mutex_unlock(&_prj_mutex)
+#endif
+#else
+#define PRJ_LOCK
+#define PRJ_UNLOCK
+#endif
+
+#ifdef S52_USE_MERC_KERNEL
+// built-in ellipsoidal Mercator (WGS84) - same math as PROJ4 merc (pj_fwd / pj_inv),
+// no lock, so the loading workers project in parallel
+// Note: PROJ is still used for anything else than the '+proj=merc' of S57_setMercPrj()
+#define MERC_A      6378137.0                     // WGS84 semi-major axis
+#define MERC_F      (1.0 / 298.257223563)         // WGS84 flattening
+#define MERC_PHI2_N 15                            // pj_phi2() max iteration
+#define MERC_PHI2_E 1.0e-10                       // pj_phi2() tolerance
+typedef struct _merc_t {
+    int    ok;      // TRUE if the destination is the Mercator of S57_setMercPrj()
+    double lon0;    // central meridian (rad)
+    double ak0;     // a * k0 - k0 scale factor at lat_ts
+    double e;       // eccentricity
+} _merc_t;
+static _merc_t _merc = {FALSE, 0.0, 0.0, 0.0};
+#endif
 
 // data for glDrawArrays()
 typedef struct _prim {
@@ -152,6 +199,17 @@ typedef struct _S57_geo {
     guint        centroidIdx;
     GArray      *centroid;
 
+    // GL2 - LS() as a VBO, uploaded on first draw, deleted by S52_GL_delDL()
+    guint        lineVBO;
+    guint        lineVBOstamp; // prjStamp of the coord in lineVBO
+    guint        prjStamp;     // bumped when coord change (projected, resized) - stale VBO
+    gboolean     geoDyn;      // TRUE if coord are edited in place (ie mariner object) - no lineVBO
+
+#ifdef S52_USE_LINE_LOD
+    // LINE - projected linexyz simplified for each LOD level (pt3), NULL until S57_setGeoLOD()
+    GArray      *lod[S57_LOD_MAX];
+#endif
+
 #ifdef S52_USE_WORLD
     S57_geo     *nextPoly;
 #endif
@@ -168,13 +226,14 @@ typedef struct _S57_geo {
 
 static GString *_attList = NULL;
 
-// tolerance used by: _inLine(), S57_isPtInSet(), posibly S57_cmpGeoExt()
+// tolerance used by: S57_isPtInSet(), posibly S57_cmpGeoExt()
 //#define S57_GEO_TOLERANCE 0.0001     // *60*60 = .36'
 //#define S57_GEO_TOLERANCE 0.00001    // *60*60 = .036'   ; * 1852 =
 //#define S57_GEO_TOLERANCE 0.000001   // *60*60 = .0036'  ; * 1852 = 6.667 meter       _simplifyGEO(): CA27904A.000 (Gulf): CTNARE:4814 poly reduction: 80% 12683 (15064	->	2381)
 #define S57_GEO_TOLERANCE 0.0000001  // *60*60 = .00036' ; * 1852 = 0.6667 meter      _simplifyGEO(): CA27904A.000 (Gulf): CTNARE:4814 poly reduction: 40%  6309 (15064	->	8755)
 //#define S57_GEO_TOLERANCE 0.00000001   // *60*60 = .000036'; * 1852 = 0.06667 meter     _simplifyGEO(): CA27904A.000 (Gulf): CTNARE:4814 poly reduction:  8%  1302 (15064	->	13762)
-#define S57_GEO_TOL_LINES 0.000001
+// _inLine(): max distance (projected metre) of a point to the line for it to be removed
+#define S57_GEO_TOL_LINES 0.5
 
 // when check for Z0=Z1=Z2
 //S57data.c:544 in _simplifyGEO(): CTNARE:4814 poly reduction: 0 (no reduction)
@@ -223,6 +282,10 @@ int        S57_donePROJ(void)
     _pjdst  = NULL;
     _doInit = TRUE;
 
+#ifdef S52_USE_MERC_KERNEL
+    g_atomic_int_set(&_merc.ok, FALSE);
+#endif
+
     if (NULL != _attList)
         g_string_free(_attList, TRUE);
     _attList = NULL;
@@ -233,6 +296,107 @@ int        S57_donePROJ(void)
     return TRUE;
 }
 
+#ifdef S52_USE_MERC_KERNEL
+static double _mercAdjlon(double lon)
+// PROJ4 adjlon() - wrap to [-PI..PI]
+{
+    if (fabs(lon) <= M_PI)
+        return lon;
+
+    lon += M_PI;
+    lon -= 2.0 * M_PI * floor(lon / (2.0 * M_PI));
+    lon -= M_PI;
+
+    return lon;
+}
+
+static void   _mercFwd(guint npt, pt3 *pt)
+// lon/lat (deg) to XY (m) in-place - Z untouched
+{
+    const double e    = _merc.e;
+    const double ak0  = _merc.ak0;
+    const double lon0 = _merc.lon0;
+
+    for (guint i=0; i<npt; ++i, ++pt) {
+        double lam  = _mercAdjlon(pt->x * DEG_TO_RAD - lon0);
+        double sphi = sin(pt->y * DEG_TO_RAD);
+
+        // y = a k0 ln(tan(PI/4 + phi/2) ((1 - e sin(phi)) / (1 + e sin(phi)))^(e/2))
+        pt->x = ak0 * lam;
+        pt->y = ak0 * (atanh(sphi) - e * atanh(e * sphi));
+    }
+
+    return;
+}
+
+static projUV _mercInv(projUV uv)
+// XY (m) to lon/lat (rad) - PROJ4 pj_phi2()
+{
+    const double e   = _merc.e;
+    double       ts  = exp(-uv.v / _merc.ak0);
+    double       phi = M_PI_2 - 2.0 * atan(ts);
+
+    for (int i=0; i<MERC_PHI2_N; ++i) {
+        double con  = e * sin(phi);
+        double dphi = M_PI_2 - 2.0 * atan(ts * pow((1.0 - con) / (1.0 + con), 0.5 * e)) - phi;
+        phi += dphi;
+        if (fabs(dphi) <= MERC_PHI2_E)
+            break;
+    }
+
+    uv.u = _mercAdjlon(uv.u / _merc.ak0 + _merc.lon0);
+    uv.v = phi;
+
+    return uv;
+}
+
+static int    _mercSet(double lat, double lon)
+{
+    double es = MERC_F * (2.0 - MERC_F);
+    double sl = sin(lat * DEG_TO_RAD);
+
+    int    ok = TRUE;
+
+    // Note: workers read _merc without lock - 'ok' is set last (see below)
+    g_atomic_int_set(&_merc.ok, FALSE);
+
+    _merc.e    = sqrt(es);
+    _merc.lon0 = lon * DEG_TO_RAD;
+    _merc.ak0  = MERC_A * cos(lat * DEG_TO_RAD) / sqrt(1.0 - es * sl * sl);  // pj_msfn()
+
+#ifdef S52_DEBUG
+    // check against PROJ4 around the projection centre
+    {
+        pt3 ptK[3] = {{lon, lat, 0.0}, {lon + 1.5, lat + 1.0, 0.0}, {lon - 2.0, lat - 0.75, 0.0}};
+        pt3 ptP[3];
+        memcpy(ptP, ptK, sizeof(ptP));
+
+        _mercFwd(3, ptK);
+
+        for (int i=0; i<3; ++i) {
+            ptP[i].x *= DEG_TO_RAD;
+            ptP[i].y *= DEG_TO_RAD;
+        }
+        if (NULL!=_pjsrc && 0==pj_transform(_pjsrc, _pjdst, 3, 3, &ptP[0].x, &ptP[0].y, &ptP[0].z)) {
+            for (int i=0; i<3; ++i) {
+                double d = hypot(ptK[i].x - ptP[i].x, ptK[i].y - ptP[i].y);
+                if (0.0005 < d) {
+                    PRINTF("WARNING: Mercator kernel off PROJ4 by %f m - kernel disabled\n", d);
+                    ok = FALSE;
+                    g_assert(0);
+                }
+            }
+        }
+    }
+#endif  // S52_DEBUG
+
+    // publish - g_atomic_*() is a full barrier
+    g_atomic_int_set(&_merc.ok, ok);
+
+    return ok;
+}
+#endif  // S52_USE_MERC_KERNEL
+
 int        S57_setMercPrj(double lat, double lon)
 {
     // From: http://trac.osgeo.org/proj/wiki/GenParms (and other link from that page)
@@ -278,32 +442,47 @@ PROJCS["WGS 84 / Pseudo-Mercator",
     // FIXME: utm tilt ENC .. why?
     //const char *templ = "+proj=utm +lat_ts=%.6f +lon_0=%.6f +ellps=WGS84 +datum=WGS84 +unit=m +no_defs";
 
-    if (NULL != _pjstr) {
+    if (NULL != S57_getPrjStr()) {
         PRINTF("WARNING: Merc projection str allready set\n");
         return FALSE;
     }
 
-    _pjstr = g_strdup_printf(templ, lat, lon);
-    PRINTF("DEBUG: lat:%f, lon:%f [%s]\n", lat, lon, _pjstr);
+    // Note: _pjstr is published last - loading / projection workers read S57_getPrjStr()
+    // without lock to know that the projection is ready
+    gchar *pjstr = g_strdup_printf(templ, lat, lon);
+    PRINTF("DEBUG: lat:%f, lon:%f [%s]\n", lat, lon, pjstr);
 
 #ifdef S52_USE_PROJ
     if (NULL != _pjdst)
         pj_free(_pjdst);
 
-    _pjdst = pj_init_plus(_pjstr);
+    _pjdst = pj_init_plus(pjstr);
     if (FALSE == _pjdst) {
         PRINTF("ERROR: init pjdst PROJ4 (lat:%f) [%s]\n", lat, pj_strerrno(pj_errno));
         g_assert(0);
+        g_free(pjstr);
         return FALSE;
     }
+
+    // init src here - not in a projection worker
+    if (TRUE == _doInit)
+        _initPROJ();
+
+#ifdef S52_USE_MERC_KERNEL
+    if (TRUE == g_str_has_prefix(templ, "+proj=merc "))
+        _mercSet(lat, lon);
+#endif
 #endif
 
+    // publish - g_atomic_*() is a full barrier
+    g_atomic_pointer_set(&_pjstr, pjstr);
+
     return TRUE;
 }
 
 CCHAR     *S57_getPrjStr(void)
 {
-    return _pjstr;
+    return (CCHAR *)g_atomic_pointer_get(&_pjstr);
 }
 
 projXY     S57_prj2geo(projUV uv)
@@ -313,6 +492,16 @@ projXY     S57_prj2geo(projUV uv)
     if (NULL == _pjdst)  return uv;
 
 #ifdef S52_USE_PROJ
+#ifdef S52_USE_MERC_KERNEL
+    if (TRUE == g_atomic_int_get(&_merc.ok)) {
+        uv = _mercInv(uv);
+        uv.u /= DEG_TO_RAD;
+        uv.v /= DEG_TO_RAD;
+
+        return uv;
+    }
+#endif
+
     uv = pj_inv(uv, _pjdst);
     if (0 != pj_errno) {
         PRINTF("ERROR: x=%f y=%f %s\n", uv.u, uv.v, pj_strerrno(pj_errno));
@@ -349,6 +538,13 @@ int        S57_geo2prj3dv(guint npt, pt3 *data)
     }
 
 #ifdef S52_USE_PROJ
+#ifdef S52_USE_MERC_KERNEL
+    if (TRUE == g_atomic_int_get(&_merc.ok)) {
+        _mercFwd(npt, pt);
+        return TRUE;
+    }
+#endif
+
     // deg to rad --latlon
     for (guint i=0; i<npt; ++i, ++pt) {
         pt->x *= DEG_TO_RAD;
@@ -359,7 +555,9 @@ int        S57_geo2prj3dv(guint npt, pt3 *data)
     pt = (pt3*)data;
 
     // rad to cartesian  --mercator
+    PRJ_LOCK;
     int ret = pj_transform(_pjsrc, _pjdst, npt, 3, &pt->x, &pt->y, &pt->z);
+    PRJ_UNLOCK;
     if (0 != ret) {
         PRINTF("WARNING: in transform (%i): %s (%f,%f)\n", ret, pj_strerrno(pj_errno), pt->x, pt->y);
         g_assert(0);
@@ -387,72 +585,75 @@ int        S57_geo2prj3dv(guint npt, pt3 *data)
 }
 
 //#if 0
-// FIXME: this break line/poly match
 static int    _inLine(pt3 A, pt3 B, pt3 C)
-// TRUE if BC is inline with AC or visa-versa
-{
-    // test.1: A( 0, 0) B(2,2) C( 4, 4)
-    // test.2: A(-2,-2) B(0,0) C(+2,+2)
-    //A.x=+2;A.y=+2;B.x=0  ;B.y=0  ;C.x=-2;C.y=-2;
-    //A.x=-2;A.y=-2;B.x=0  ;B.y=0  ;C.x=+2;C.y=+2;
-    //A.x=-2;A.y=-2;B.x=-11;B.y=-11;C.x=+2;C.y=+2;
-
-    // from: https://stackoverflow.com/questions/17692922/check-is-a-point-x-y-is-between-two-points-drawn-on-a-straight-line/17693189
-    // if AC is vertical
-    //if (A.x == C.x) return B.x == C.x;
-    if (ABS(A.x-C.x) < S57_GEO_TOL_LINES) return ABS(B.x-C.x) < S57_GEO_TOL_LINES;
-
-    // if AC is horizontal
-    //if (A.y == C.y) return B.y == C.y;
-    if (ABS(A.y-C.y) < S57_GEO_TOL_LINES) return ABS(B.y-C.y) < S57_GEO_TOL_LINES;
-
-    // match the gradients (BUG: maybe after edit of '/' to '*')
-    //return (A.x - C.x)*(A.y - C.y) == (C.x - B.x)*(C.y - B.y);
-    //ex: -4*-4 == 2*2 = 16 == 4 !?!
-
-    // slope: (y2-y1)/(x2-x1)
-    // so slope AC == slope BC
-    //return (A.y-C.y)/(A.x-C.x) == (B.y-C.y)/(B.x-C.x);  // div 0, need test above
-    //return (A.y-C.y)*(B.x-C.x) == (B.y-C.y)*(A.x-C.x);  // inf
-    return ABS(ABS((A.y-C.y)*(B.x-C.x)) - ABS((B.y-C.y)*(A.x-C.x))) < S57_GEO_TOL_LINES;
-
-    // determinant = (ax-cx)(by-cy) - (bx-cx)(ay-cy)
-    //return (A.x - C.x)*(B.y - C.y) == (B.x - C.x)*(A.y - C.y);
-    // >0 above, <0 bellow, =0 on line
-    // ex: (0-4)(2-4) - (2-4)(0-4) = 8-8 = 0
-}
-
-static guint  _delInLineSeg(guint npt, double *ppt)
-// remove point ON the line segment
-{
-    //* FIXME: optimisation: use pt3 newArr[npt];
-    // and only one memmove(ppt, newArr, sizeof(pt3) * j);  (see fail test bellow)
-    //pt3 newArr[npt]; guint ii = 0, k = 0;
-
-    pt3  *p = (pt3*)ppt;
-    guint j = npt;
-    for (guint i=0; i<(npt-2); ++i) {
-
-        //if (p[0].z == p[1].z == p[2].z) {
-        if (p[0].z == p[2].z) {
-            // remove p[1]
-            if (TRUE == _inLine(p[0], p[1], p[2])) {
-                // A--B--C,       3-0-2=1
-                // 0--A--B--C,    4-1-2=1
-                // 0--A--B--C--0, 5-1-2=2
-                memmove(&p[1], &p[2], sizeof(pt3) * (npt - i - 2));
-                --j;
-            } else {
-                ++p;
-            }
-        } else {
-            ++p;
-        }
+// TRUE if B is on segment AC - within S57_GEO_TOL_LINES
+// Note: projected coordinate (metre) - see S57_geo2prj()
+{
+    double ACx  = C.x - A.x;
+    double ACy  = C.y - A.y;
+    double ABx  = B.x - A.x;
+    double ABy  = B.y - A.y;
+    double len2 = ACx*ACx + ACy*ACy;
+    double tol2 = S57_GEO_TOL_LINES * S57_GEO_TOL_LINES;
+
+    // A and C (almost) the same point - B is a corner or a spike
+    if (len2 < tol2)
+        return FALSE;
+
+    // B project outside AC - spike
+    double dot = ABx*ACx + ABy*ACy;
+    if ((dot < 0.0) || (len2 < dot))
+        return FALSE;
+
+    // signed cross product (C-A)x(B-A) = |AC| * distance of B to line AC
+    double cross = ACx*ABy - ACy*ABx;
+
+    return (cross*cross <= tol2*len2) ? TRUE : FALSE;
+}
+
+static guint  _delInLineRun(guint npt, pt3 *p, gboolean compact)
+// one pass over the line: a point is removed when it is in line with the last kept
+// point and the next point, and these two have the same Z (S57_OVERLAP_GEO_Z)
+// compact: write kept point in place (write cursor always behind read cursor)
+// return the number of point kept
+{
+    pt3   prev = p[0];
+    guint j    = 1;
+
+    for (guint i=1; i<(npt-1); ++i) {
+        if ((prev.z == p[i+1].z) && (TRUE == _inLine(prev, p[i], p[i+1])))
+            continue;
+
+        prev = p[i];
+        if (TRUE == compact)
+            p[j] = prev;
+        ++j;
     }
 
+    if (TRUE == compact)
+        p[j] = p[npt-1];
+
+    return j + 1;
+}
+
+static guint  _delInLineSeg(guint npt, double *ppt, guint nmin)
+// remove point ON the line segment - linear time
+// return npt (data untouched) if less than nmin point would be left
+{
+    pt3 *p = (pt3*)ppt;
+
+    if (npt < 3)
+        return npt;
+
+    // count first - keep degenerated geo as is
+    guint j = _delInLineRun(npt, p, FALSE);
+    if ((j == npt) || (j < nmin))
+        return npt;
+
+    j = _delInLineRun(npt, p, TRUE);
+
 #ifdef S52_DEBUG
     /* debug: check for duplicate vertex
-    p = (pt3*)ppt;
     guint nDup = 0;
     for (guint i=1; i<j; ++i) {
         if ((p[i-1].x == p[i].x) && (p[i-1].y == p[i].y)) {
@@ -468,37 +669,6 @@ static guint  _delInLineSeg(guint npt, double *ppt)
 #endif  // S52_DEBUG
 
     return j;
-
-    /*
-    if (TRUE == _inLine(p[0], p[k+1], p[k+2])) {
-        --j;
-        ++k;
-    } else {
-        newArr[ii++] = *p++;
-        p += k;
-    }
-    //memmove(ppt, newArr, sizeof(pt3) * j);
-    */
-
-    /* FIXME: this fail
-    pt3  newArr[npt];
-    guint i = 0, j = 0, k = 0;
-    while (i<(npt-2)) {
-        if (TRUE == _inLine(p[0], p[k+1], p[k+2])) {
-            ++k;
-        } else {
-            newArr[j++] = p[0];
-            if (0 < k) {
-                //newArr[j++] = p[k];
-                //newArr[j++] = p[k+1];  // p[k+2]
-                newArr[j++] = p[k-1];  // p[old_k]
-                k = 0;
-            }
-        }
-        ++p;
-        ++i;
-    }
-    */
 }
 
 static int    _simplifyGEO(_S57_geo *geo)
@@ -508,7 +678,7 @@ static int    _simplifyGEO(_S57_geo *geo)
 
         // need at least 3 pt
         if (2 < geo->linexyznbr) {
-            guint npt = _delInLineSeg(geo->linexyznbr, geo->linexyz);
+            guint npt = _delInLineSeg(geo->linexyznbr, geo->linexyz, 2);
             if (npt != geo->linexyznbr) {
                 //PRINTF("DEBUG: line reduction: %i \t(%i\t->\t%i)\n", geo->linexyznbr - npt, geo->linexyznbr, npt);
                 geo->linexyznbr = npt;
@@ -527,9 +697,9 @@ static int    _simplifyGEO(_S57_geo *geo)
     if (S57_AREAS_T == geo->objType) {
         for (guint i=0; i<geo->ringnbr; ++i) {
             if (3 < geo->ringxyznbr[i]) {
-                guint npt = _delInLineSeg(geo->ringxyznbr[i], geo->ringxyz[i]);
+                guint npt = _delInLineSeg(geo->ringxyznbr[i], geo->ringxyz[i], 4);
                 if (npt != geo->ringxyznbr[i]) {
-                    PRINTF("DEBUG: %s:%i poly reduction: %i \t(%i\t->\t%i)\n", geo->name, geo->S57ID, geo->ringxyznbr[i] - npt, geo->ringxyznbr[i], npt);
+                    //PRINTF("DEBUG: %s:%i poly reduction: %i \t(%i\t->\t%i)\n", geo->name, geo->S57ID, geo->ringxyznbr[i] - npt, geo->ringxyznbr[i], npt);
                     geo->ringxyznbr[i] = npt;
                 }
             }
@@ -551,26 +721,34 @@ static int    _simplifyGEO(_S57_geo *geo)
 }
 //#endif  // 0
 
+#ifdef S52_USE_LINE_LOD
+static int    _doneGeoLOD(_S57_geo *geo)
+{
+    for (guint i=0; i<S57_LOD_MAX; ++i) {
+        if (NULL != geo->lod[i]) {
+            g_array_free(geo->lod[i], TRUE);
+            geo->lod[i] = NULL;
+        }
+    }
+
+    return TRUE;
+}
+#endif
+
 int        S57_geo2prj(_S57_geo *geo)
 {
     // useless - rbin
     //return_if_null(geo);
 
-    // FIXME: this break line/poly match
-    // FIX: call on area object with a sy() (centroid in area) and no AC() or AP()
-    if ('A' == geo->objType) {
-        if ((0 == g_strcmp0(geo->name, "ISTZNE")) ||
-            (0 == g_strcmp0(geo->name, "TSSLPT")) ||
-            (0 == g_strcmp0(geo->name, "CTNARE")))   // LC()
-        {
-            _simplifyGEO(geo);
-        }
-    }
-
     if (TRUE == _doInit)
         _initPROJ();
 
 #ifdef S52_USE_PROJ
+#ifdef S52_USE_LINE_LOD
+    // LOD of the previous projection - rebuilt by the caller (S57_setGeoLOD())
+    _doneGeoLOD(geo);
+#endif
+
     guint nr = S57_getRingNbr(geo);
     for (guint i=0; i<nr; ++i) {
         guint   npt;
@@ -580,8 +758,17 @@ int        S57_geo2prj(_S57_geo *geo)
                 return FALSE;
         }
     }
+
+    // remove collinear point of all line and area - in metre, hence after projection
+    // Note: run after _suppLineOverlap() has marked the overlap in Z - a Z transition
+    // is never removed, so line/poly edge match is kept
+    if ((FALSE == geo->geoDyn) && (S57_LINES_T==geo->objType || S57_AREAS_T==geo->objType)) {
+        _simplifyGEO(geo);
+    }
 #endif  // S52_USE_PROJ
 
+    ++geo->prjStamp;
+
     return TRUE;
 }
 
@@ -654,6 +841,10 @@ int        S57_doneData   (_S57_geo *geo, gpointer user_data)
     if (NULL != geo->centroid)
         g_array_free(geo->centroid, TRUE);
 
+#ifdef S52_USE_LINE_LOD
+    _doneGeoLOD(geo);
+#endif
+
     g_free(geo);
 
     return TRUE;
@@ -669,7 +860,7 @@ S57_geo   *S57_setPOINT(geocoord *xyz)
     if (NULL == geo)
         g_assert(0);
 
-    geo->S57ID    = _S57ID++;
+    geo->S57ID    = S57_NEWID;
     geo->objType  = S57_POINT_T;
     geo->pointxyz = xyz;
 
@@ -712,7 +903,7 @@ S57_geo   *S57_setLINES(guint xyznbr, geocoord *xyz)
     if (NULL == geo)
         g_assert(0);
 
-    geo->S57ID      = _S57ID++;
+    geo->S57ID      = S57_NEWID;
     geo->objType    = S57_LINES_T;
     geo->linexyznbr = xyznbr;
     geo->linexyz    = xyz;
@@ -769,7 +960,7 @@ S57_geo   *S57_setAREAS(guint ringnbr, guint *ringxyznbr, geocoord **ringxyz)
     if (NULL == geo)
         g_assert(0);
 
-    geo->S57ID      = _S57ID++;
+    geo->S57ID      = S57_NEWID;
     geo->objType    = S57_AREAS_T;
     geo->ringnbr    = ringnbr;
     geo->ringxyznbr = ringxyznbr;
@@ -803,7 +994,7 @@ S57_geo   *S57_set_META(void)
     if (NULL == geo)
         g_assert(0);
 
-    geo->S57ID  = _S57ID++;
+    geo->S57ID  = S57_NEWID;
     geo->objType= S57__META_T;
 
     geo->ext.W  =  INFINITY;
@@ -1505,6 +1696,14 @@ GString   *S57_getAttValALL(_S57_geo *geo, const char *attName)
     return attVal;
 }
 
+GString   *S57_getAttValQ(_S57_geo *geo, GQuark attName)
+// return attribute string value or NULL if attribute value abscent
+{
+    return_if_null(geo);
+
+    return (GString*) g_datalist_id_get_data(&geo->attribs, attName);
+}
+
 static void   _string_free(gpointer data)
 {
     g_string_free((GString*)data, TRUE);
@@ -2056,6 +2255,57 @@ gboolean   S57_isPtOnLine(_S57_geo *geoLine, double x, double y)
     return FALSE;
 }
 
+gboolean   S57_isPtNearRing(guint npt, pt3 *ppt, double x, double y, double dx, double dy)
+// return TRUE if a vertex or a segment of the ring (or line) fall inside the box x+-dx, y+-dy, else FALSE
+// Note: dx,dy is the tolerance (ex: pick extent in PRJ), npt=1 test a point
+{
+    return_if_null(ppt);
+
+    double W = x - dx;
+    double E = x + dx;
+    double S = y - dy;
+    double N = y + dy;
+
+    for (guint i=0; i<npt; ++i) {
+        pt3 p1 = ppt[i];
+
+        // vertex inside
+        if (W<=p1.x && p1.x<=E && S<=p1.y && p1.y<=N)
+            return TRUE;
+
+        if (i+1 == npt)
+            break;
+
+        // clip segment to box (Liang-Barsky)
+        pt3    p2   = ppt[i+1];
+        double t0   = 0.0;
+        double t1   = 1.0;
+        double p[4] = {p1.x - p2.x, p2.x - p1.x, p1.y - p2.y, p2.y - p1.y};
+        double q[4] = {p1.x - W,    E - p1.x,    p1.y - S,    N - p1.y   };
+
+        gboolean out = FALSE;
+        for (int k=0; k<4 && FALSE==out; ++k) {
+            if (0.0 == p[k]) {
+                // parallel to this edge and outside
+                if (q[k] < 0.0)
+                    out = TRUE;
+            } else {
+                double t = q[k] / p[k];
+                if (p[k] < 0.0) {
+                    if (t > t1) out = TRUE; else if (t > t0) t0 = t;
+                } else {
+                    if (t < t0) out = TRUE; else if (t < t1) t1 = t;
+                }
+            }
+        }
+
+        if (FALSE == out)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
 #if 0
 gboolean   S57_touchArea(_S57_geo *geoArea, _S57_geo *geo)
 // TRUE if A touch B else FALSE
@@ -2124,6 +2374,9 @@ guint      S57_setGeoSize(_S57_geo *geo, guint size)
         return FALSE;
     }
 
+    if (size != geo->geoSize)
+        ++geo->prjStamp;
+
     return geo->geoSize = size;
 }
 
@@ -2188,6 +2441,193 @@ int        S57_hasCentroid(_S57_geo *geo)
     return TRUE;
 }
 
+int        S57_setLineVBO(_S57_geo *geo, guint vboID)
+{
+    return_if_null(geo);
+
+    geo->lineVBO      = vboID;
+    geo->lineVBOstamp = geo->prjStamp;
+
+    return TRUE;
+}
+
+guint      S57_getLineVBO(_S57_geo *geo, gboolean *stale)
+{
+    return_if_null(geo);
+
+    if (NULL != stale)
+        *stale = (geo->lineVBOstamp != geo->prjStamp) ? TRUE : FALSE;
+
+    return geo->lineVBO;
+}
+
+int        S57_setGeoDyn(_S57_geo *geo, gboolean dyn)
+{
+    return_if_null(geo);
+
+    geo->geoDyn = dyn;
+
+    return TRUE;
+}
+
+gboolean   S57_getGeoDyn(_S57_geo *geo)
+{
+    return_if_null(geo);
+
+    return geo->geoDyn;
+}
+
+#ifdef S52_USE_LINE_LOD
+// RDP tolerance (meter) of each level: 0.3 mm (a pixel) at the largest scale of
+// the IHO navigational purpose band (see _computeCentroid() in S52GL.c)
+static const double _lodTol[S57_LOD_MAX] = {
+    0.0,                   // 0 - Berthing - original vertex
+    0.0003 *    4000.0,    // 1 - Harbour  -   1.2 m
+    0.0003 *   22000.0,    // 2 - Approach -   6.6 m
+    0.0003 *   90000.0,    // 3 - Coastal  -  27.0 m
+    0.0003 *  350000.0,    // 4 - General  - 105.0 m
+    0.0003 * 1500000.0     // 5 - Overview - 450.0 m
+};
+
+static double _segDist2(pt3 *A, pt3 *B, pt3 *P)
+// square distance from P to segment AB
+{
+    double dx = B->x - A->x;
+    double dy = B->y - A->y;
+    double l2 = dx*dx + dy*dy;
+    double t  = (0.0 == l2) ? 0.0 : ((P->x - A->x)*dx + (P->y - A->y)*dy) / l2;
+
+    t = CLAMP(t, 0.0, 1.0);
+
+    double x = A->x + t*dx - P->x;
+    double y = A->y + t*dy - P->y;
+
+    return x*x + y*y;
+}
+
+static guint  _simplifyRDP(guint npt, pt3 *p, double tol, GArray *out)
+// Ramer-Douglas-Peucker - append the kept vertex of p to out
+// Note: end point and Z transition (S57_OVERLAP_GEO_Z) are always kept, so
+// an Edge shared by adjacent area simplify the same way for both
+{
+    guint8 *keep  = g_new0(guint8, npt);
+    GArray *stack = g_array_new(FALSE, FALSE, sizeof(guint));
+    double  tol2  = tol * tol;
+
+    keep[0]     = 1;
+    keep[npt-1] = 1;
+    for (guint i=1; i<npt; ++i) {
+        if (p[i-1].z != p[i].z) {
+            keep[i-1] = 1;
+            keep[i]   = 1;
+        }
+    }
+
+    // one run between each pair of anchor
+    guint anchor = 0;
+    for (guint i=1; i<npt; ++i) {
+        if (1 == keep[i]) {
+            if (1 < i-anchor) {
+                g_array_append_val(stack, anchor);
+                g_array_append_val(stack, i);
+            }
+            anchor = i;
+        }
+    }
+
+    // iterative - no recursion on long coastline
+    while (0 < stack->len) {
+        guint b = g_array_index(stack, guint, stack->len-1);
+        guint a = g_array_index(stack, guint, stack->len-2);
+        g_array_set_size(stack, stack->len-2);
+
+        double dmax = 0.0;
+        guint  imax = a;
+        for (guint i=a+1; i<b; ++i) {
+            double d = _segDist2(&p[a], &p[b], &p[i]);
+            if (d > dmax) {
+                dmax = d;
+                imax = i;
+            }
+        }
+
+        if (dmax > tol2) {
+            keep[imax] = 1;
+            if (1 < imax-a) {
+                g_array_append_val(stack, a);
+                g_array_append_val(stack, imax);
+            }
+            if (1 < b-imax) {
+                g_array_append_val(stack, imax);
+                g_array_append_val(stack, b);
+            }
+        }
+    }
+
+    for (guint i=0; i<npt; ++i) {
+        if (1 == keep[i])
+            g_array_append_val(out, p[i]);
+    }
+
+    g_array_free(stack, TRUE);
+    g_free(keep);
+
+    return out->len;
+}
+
+int        S57_setGeoLOD(_S57_geo *geo)
+{
+    return_if_null(geo);
+
+    _doneGeoLOD(geo);
+
+    if ((S57_LINES_T != geo->objType) || (TRUE == geo->geoDyn) || (geo->linexyznbr < 3))
+        return FALSE;
+
+    // build all level - each from the previous one
+    guint n = geo->linexyznbr;
+    pt3  *p = (pt3*)geo->linexyz;
+    for (guint i=1; i<S57_LOD_MAX; ++i) {
+        geo->lod[i] = g_array_new(FALSE, FALSE, sizeof(pt3));
+        n = _simplifyRDP(n, p, _lodTol[i], geo->lod[i]);
+        p = (pt3*)geo->lod[i]->data;
+    }
+
+    return TRUE;
+}
+
+guint      S57_getGeoLODnbr(_S57_geo *geo)
+{
+    return_if_null(geo);
+
+    return (NULL == geo->lod[1]) ? 1 : S57_LOD_MAX;
+}
+
+int        S57_getGeoLOD(_S57_geo *geo, guint level, guint *npt, double **ppt)
+{
+    return_if_null(geo);
+
+    if ((0 == level) || (S57_LOD_MAX <= level) || (NULL == geo->lod[level]))
+        return S57_getGeoData(geo, 0, npt, ppt);
+
+    *npt = geo->lod[level]->len;
+    *ppt = (double*)geo->lod[level]->data;
+
+    return TRUE;
+}
+
+guint      S57_getLODlevel(double mpp)
+{
+    guint level = 0;
+    for (guint i=1; i<S57_LOD_MAX; ++i) {
+        if (_lodTol[i] <= mpp)
+            level = i;
+    }
+
+    return level;
+}
+#endif  // S52_USE_LINE_LOD
+
 #ifdef S52_USE_SUPP_LINE_OVERLAP
 S57_geo   *S57_getEdgeOwner(_S57_geo *geoEdge)
 {
@@ -2410,10 +2850,471 @@ char       S57_getLOD(_S52_obj *obj)
 #endif  // 0
 
 
-#if 0
+#ifdef S52_USE_CELL_CACHE
+// flat record of a S57_geo in the cell cache (native byte order)
+// followed by: ring size, XYZ, attributes (name\0value\0), prim, vertex - each part 8 bytes aligned
+typedef struct _cacheRec {
+    guint32   recLen;                    // total lenght of this record (header included)
+    char      name[S57_GEO_NM_LN+1];
+    guchar    objType;
+    guchar    pad[1];
+    guint32   geoSize;
+    guint32   nRing;                     // 1 - POINT/LINE, ringnbr - AREA, 0 - META
+    guint32   nAtt;
+    guint32   nPrim;
+    guint32   nVert;
+    ObjExt_t  ext;
+    double    scamin;
+} _cacheRec;
+
+#define CACHE_ALIGN(n)  (((n) + 7) & ~7)
+
+static void   _cachePad(GByteArray *buf)
+{
+    static const guint8 zero[8] = {0};
+    guint len = buf->len;
+    if (len != CACHE_ALIGN(len))
+        g_byte_array_append(buf, zero, CACHE_ALIGN(len) - len);
+}
+
+typedef struct _cacheAttBuf {
+    GByteArray *buf;
+    guint32     nAtt;
+} _cacheAttBuf;
+
+static void   _cacheAtt(GQuark key_id, gpointer data, gpointer user_data)
+{
+    _cacheAttBuf *att   = (_cacheAttBuf*)user_data;
+    GString      *value = (GString*)data;
+    const gchar  *name  = g_quark_to_string(key_id);
+
+    g_byte_array_append(att->buf, (const guint8*)name,       strlen(name) + 1);
+    g_byte_array_append(att->buf, (const guint8*)value->str, value->len   + 1);
+    ++att->nAtt;
+}
+
+int        S57_geo2cache(_S57_geo *geo, GByteArray *buf)
+// append a flat record of 'geo' to 'buf'
+{
+    return_if_null(geo);
+    return_if_null(buf);
+
+    guint     start = buf->len;
+    _cacheRec rec;
+
+    memset(&rec, 0, sizeof(rec));
+    memcpy(rec.name, geo->name, S57_GEO_NM_LN+1);
+    rec.objType = geo->objType;
+    rec.geoSize = geo->geoSize;
+    rec.nRing   = S57_getRingNbr(geo);
+    rec.nAtt    = 0;     // patched bellow
+    rec.nPrim   = (NULL == geo->prim) ? 0 : geo->prim->list->len;
+    rec.nVert   = (NULL == geo->prim) ? 0 : geo->prim->vertex->len;
+    rec.ext     = geo->ext;
+    rec.scamin  = geo->scamin;
+
+    g_byte_array_append(buf, (const guint8*)&rec, sizeof(rec));
+    _cachePad(buf);
+
+    // ring size
+    for (guint i=0; i<rec.nRing; ++i) {
+        guint   npt = 0;
+        double *ppt = NULL;
+        S57_getGeoData(geo, i, &npt, &ppt);
+        guint32 n = npt;
+        g_byte_array_append(buf, (const guint8*)&n, sizeof(guint32));
+    }
+    _cachePad(buf);
+
+    // XYZ
+    for (guint i=0; i<rec.nRing; ++i) {
+        guint   npt = 0;
+        double *ppt = NULL;
+        if (TRUE == S57_getGeoData(geo, i, &npt, &ppt))
+            g_byte_array_append(buf, (const guint8*)ppt, npt * sizeof(pt3));
+    }
+
+    // attributes
+    _cacheAttBuf att = {buf, 0};
+    if (NULL != geo->attribs)
+        g_datalist_foreach(&geo->attribs, _cacheAtt, &att);
+    _cachePad(buf);
+
+    // tessellated area
+    if (0 != rec.nPrim) {
+        g_byte_array_append(buf, (const guint8*)geo->prim->list->data,   rec.nPrim * sizeof(_prim));
+        _cachePad(buf);
+        g_byte_array_append(buf, (const guint8*)geo->prim->vertex->data, rec.nVert * sizeof(vertex_t) * 3);
+        _cachePad(buf);
+    }
+
+    // patch record lenght and attributes count
+    ((_cacheRec*)(buf->data + start))->recLen = buf->len - start;
+    ((_cacheRec*)(buf->data + start))->nAtt   = att.nAtt;
+
+    return TRUE;
+}
+
+S57_geo   *S57_cache2geo(const guchar **data, const guchar *end)
+// build a new S57_geo from the flat record at 'data'
+// advance 'data' to the next record, return NULL on a corrupted record
+// Note: every lenght is checked against the end of the record (truncated / stale / corrupt cache)
+{
+    return_if_null(data);
+    return_if_null(*data);
+    return_if_null(end);
+
+    const guchar *p = *data;
+    _cacheRec     rec;
+
+    if ((p > end) || ((guint64)(end - p) < sizeof(rec)))
+        return NULL;
+    memcpy(&rec, p, sizeof(rec));
+    // Note: S57_geo2cache() pad every record - an unaligned lenght is corrupt
+    if ((rec.recLen < CACHE_ALIGN(sizeof(rec))) || (0 != (rec.recLen & 7)) || ((guint64)(end - p) < rec.recLen))
+        return NULL;
+    rec.name[S57_GEO_NM_LN] = '\0';
+
+    const guchar *recBeg = p;
+    const guchar *recEnd = p + rec.recLen;
+
+// TRUE if 'n' bytes are left in the record at 'p' (p past recEnd after an align: FALSE)
+#define CACHE_HAS(n)  ((p <= recEnd) && ((guint64)(recEnd - p) >= (guint64)(n)))
+
+    p += CACHE_ALIGN(sizeof(rec));
+
+    // ring size
+    if (!CACHE_HAS(CACHE_ALIGN((guint64)rec.nRing * sizeof(guint32))))
+        return NULL;
+    const guint32 *ringSz = (const guint32*)p;
+    p += CACHE_ALIGN(rec.nRing * sizeof(guint32));
+
+    // XYZ - check total before any alloc
+    guint64 nPt = 0;
+    for (guint i=0; i<rec.nRing; ++i) {
+        nPt += ringSz[i];
+        // no overflow of nPt * sizeof(pt3) below
+        if (rec.recLen < nPt)
+            return NULL;
+    }
+    if (!CACHE_HAS(nPt * sizeof(pt3)))
+        return NULL;
+
+    _S57_geo *geo = NULL;
+    switch (rec.objType) {
+        case S57_POINT_T: {
+            if ((1 != rec.nRing) || (1 != ringSz[0]))
+                return NULL;
+            geocoord *xyz = g_new(geocoord, 3);
+            memcpy(xyz, p, sizeof(pt3));
+            p  += sizeof(pt3);
+            geo = S57_setPOINT(xyz);
+            break;
+        }
+        case S57_LINES_T: {
+            if ((1 != rec.nRing) || (0 == ringSz[0]))
+                return NULL;
+            geocoord *xyz = g_new(geocoord, ringSz[0] * 3);
+            memcpy(xyz, p, ringSz[0] * sizeof(pt3));
+            p  += ringSz[0] * sizeof(pt3);
+            geo = S57_setLINES(ringSz[0], xyz);
+            break;
+        }
+        case S57_AREAS_T: {
+            if (0 == rec.nRing)
+                return NULL;
+            guint     *ringxyznbr = g_new(guint,      rec.nRing);
+            geocoord **ringxyz    = g_new(geocoord*,  rec.nRing);
+            for (guint i=0; i<rec.nRing; ++i) {
+                ringxyznbr[i] = ringSz[i];
+                ringxyz[i]    = g_new(geocoord, ringSz[i] * 3);
+                memcpy(ringxyz[i], p, ringSz[i] * sizeof(pt3));
+                p += ringSz[i] * sizeof(pt3);
+            }
+            geo = S57_setAREAS(rec.nRing, ringxyznbr, ringxyz);
+            break;
+        }
+        case S57__META_T:
+            if (0 != rec.nRing)
+                return NULL;
+            geo = S57_set_META();
+            break;
+
+        default:
+            PRINTF("WARNING: invalid object type in cache (%c)\n", rec.objType);
+            return NULL;
+    }
+
+    S57_setName(geo, rec.name);
+    geo->geoSize = rec.geoSize;
+    geo->ext     = rec.ext;
+    geo->scamin  = rec.scamin;
+
+    // attributes - name\0value\0, '\0' must be inside the record
+    for (guint i=0; i<rec.nAtt; ++i) {
+        const guchar *nul = NULL;
+
+        const char *name = (const char *)p;
+        if ((p >= recEnd) || (NULL == (nul = memchr(p, '\0', recEnd - p))))
+            goto fail;
+        p = nul + 1;
+
+        const char *val  = (const char *)p;
+        if ((p >= recEnd) || (NULL == (nul = memchr(p, '\0', recEnd - p))))
+            goto fail;
+        p = nul + 1;
+
+        S57_setAtt(geo, name, val);
+    }
+    p = recBeg + CACHE_ALIGN(p - recBeg);
+    if (p > recEnd)
+        goto fail;
+
+    if (0 != rec.nPrim) {
+        if (!CACHE_HAS(CACHE_ALIGN((guint64)rec.nPrim * sizeof(_prim))))
+            goto fail;
+        S57_prim *prim = S57_initPrimGeo(geo);
+        g_array_append_vals(prim->list,   p, rec.nPrim);
+        p = recBeg + CACHE_ALIGN((p - recBeg) + rec.nPrim * sizeof(_prim));
+
+        if (!CACHE_HAS((guint64)rec.nVert * sizeof(vertex_t) * 3))
+            goto fail;
+        g_array_append_vals(prim->vertex, p, rec.nVert);
+    }
+
+#undef CACHE_HAS
+
+    *data = recEnd;
+
+    return geo;
+
+fail:
+    PRINTF("WARNING: corrupted record in cache (%s)\n", rec.name);
+    S57_doneData(geo, NULL);
+
+    return NULL;
+}
+#endif  // S52_USE_CELL_CACHE
+
+#ifdef S52_USE_RTREE
+// packed R-tree - bulk loaded (Sort-Tile-Recursive), read-only once built
+// level 0 hold the extent of the items, level n+1 the union of RTREE_NODE entries of level n
+#define RTREE_NODE     16
+#define RTREE_MAXLEVEL 16
+
+typedef struct _rtreeItem {
+    ObjExt_t ext;
+    guint    idx;     // index of item in caller array
+    double   cx, cy;  // center - sort key
+} _rtreeItem;
+
+struct _S57_rtree {
+    guint     n;                          // number of items
+    guint     nLevel;
+    guint     level[RTREE_MAXLEVEL+1];    // offset of each level in ext - level[nLevel] is the root end
+    ObjExt_t *ext;
+    guint    *idx;                        // level 0 item index in caller array
+};
+
+static int        _cmpItemX(gconstpointer a, gconstpointer b)
+{
+    double ax = ((const _rtreeItem *)a)->cx;
+    double bx = ((const _rtreeItem *)b)->cx;
+
+    return (ax < bx) ? -1 : (ax > bx) ? 1 : 0;
+}
+
+static int        _cmpItemY(gconstpointer a, gconstpointer b)
+{
+    double ay = ((const _rtreeItem *)a)->cy;
+    double by = ((const _rtreeItem *)b)->cy;
+
+    return (ay < by) ? -1 : (ay > by) ? 1 : 0;
+}
+
+static double     _extCenter(double a, double b)
+{
+    double c = (a + b) / 2.0;
+
+    // inf extent (not set) - sort with the rest, it is tested at the root anyway
+    return (0 == isfinite(c)) ? 0.0 : c;
+}
+
+S57_rtree *S57_newRTree(ObjExt_t *ext, guint n)
+// bulk load the extent of n items
+{
+    S57_rtree *tree = g_new0(S57_rtree, 1);
+
+    tree->n = n;
+    if (0 == n)
+        return tree;
+
+    _rtreeItem *items = g_new(_rtreeItem, n);
+    for (guint i=0; i<n; ++i) {
+        ObjExt_t e = ext[i];
+
+        // anti-meridian (or not set) - index as all longitude, the caller do the exact test
+        if (e.W > e.E) {
+            e.W = -INFINITY;
+            e.E =  INFINITY;
+        }
+        items[i].ext = e;
+        items[i].idx = i;
+        items[i].cx  = _extCenter(e.W, e.E);
+        items[i].cy  = _extCenter(e.S, e.N);
+    }
+
+    // STR: sort by x, cut in vertical slices of nSlice nodes, sort each slice by y
+    guint nLeaf  = (n + RTREE_NODE - 1) / RTREE_NODE;
+    guint nSlice = (guint) ceil(sqrt((double)nLeaf));
+    guint sliceN = nSlice * RTREE_NODE;
+
+    qsort(items, n, sizeof(_rtreeItem), _cmpItemX);
+    for (guint i=0; i<n; i+=sliceN) {
+        guint cnt = MIN(sliceN, n - i);
+        qsort(items + i, cnt, sizeof(_rtreeItem), _cmpItemY);
+    }
+
+    // size of all level
+    guint nTotal = 0;
+    guint nLevel = 0;
+    for (guint cnt=n; ; cnt=(cnt+RTREE_NODE-1)/RTREE_NODE) {
+        tree->level[nLevel++] = nTotal;
+        nTotal += cnt;
+        if ((1==cnt) || (RTREE_MAXLEVEL==nLevel))
+            break;
+    }
+    tree->level[nLevel] = nTotal;
+    tree->nLevel        = nLevel;
+
+    tree->ext = g_new(ObjExt_t, nTotal);
+    tree->idx = g_new(guint,    n);
+    for (guint i=0; i<n; ++i) {
+        tree->ext[i] = items[i].ext;
+        tree->idx[i] = items[i].idx;
+    }
+    g_free(items);
+
+    // union of children
+    for (guint l=1; l<nLevel; ++l) {
+        guint child = tree->level[l-1];
+        guint end   = tree->level[l];
+        for (guint k=tree->level[l]; k<tree->level[l+1]; ++k) {
+            ObjExt_t u = { INFINITY, INFINITY, -INFINITY, -INFINITY};
+            for (guint c=0; c<RTREE_NODE && child<end; ++c, ++child) {
+                u.W = MIN(u.W, tree->ext[child].W);
+                u.S = MIN(u.S, tree->ext[child].S);
+                u.E = MAX(u.E, tree->ext[child].E);
+                u.N = MAX(u.N, tree->ext[child].N);
+            }
+            tree->ext[k] = u;
+        }
+    }
+
+    return tree;
+}
+
+S57_rtree *S57_doneRTree(S57_rtree *tree)
+{
+    if (NULL == tree)
+        return NULL;
+
+    g_free(tree->ext);
+    g_free(tree->idx);
+    g_free(tree);
+
+    return NULL;
+}
+
+guint      S57_getRTreeSize(S57_rtree *tree)
+{
+    return (NULL == tree) ? 0 : tree->n;
+}
+
+static void       _queryRTree(S57_rtree *tree, guint l, guint k, ObjExt_t view, GArray *res)
+{
+    if (FALSE == S57_cmpExt(tree->ext[k], view))
+        return;
+
+    if (0 == l) {
+        g_array_append_val(res, tree->idx[k]);
+        return;
+    }
+
+    guint child = tree->level[l-1] + (k - tree->level[l]) * RTREE_NODE;
+    guint end   = MIN(child + RTREE_NODE, tree->level[l]);
+    for (; child<end; ++child)
+        _queryRTree(tree, l-1, child, view, res);
+
+    return;
+}
+
+static int        _cmpIdx(gconstpointer a, gconstpointer b)
+{
+    guint ia = *(const guint *)a;
+    guint ib = *(const guint *)b;
+
+    return (ia < ib) ? -1 : (ia > ib) ? 1 : 0;
+}
+
+guint      S57_queryRTree(S57_rtree *tree, ObjExt_t view, GArray *res)
+// append to res (guint) the index of the items that intersect view - in the same order as the items
+// return the number of items found
+{
+    if ((NULL==tree) || (0==tree->n))
+        return 0;
+
+    guint len = res->len;
+
+    // root level can have more than one node if RTREE_MAXLEVEL is reach
+    guint top = tree->nLevel - 1;
+    for (guint k=tree->level[top]; k<tree->level[top+1]; ++k)
+        _queryRTree(tree, top, k, view, res);
+
+    // keep caller order
+    qsort(&g_array_index(res, guint, len), res->len - len, sizeof(guint), _cmpIdx);
+
+    return res->len - len;
+}
+#endif  // S52_USE_RTREE
+
+#ifdef S57_MAIN_DELINLINE
+// micro-benchmark: _delInLineSeg() on large ring (time should grow linearly)
+// $ gcc -std=gnu99 -O2 -DS57_MAIN_DELINLINE S57data.c S52utils.c `pkg-config --cflags --libs glib-2.0` -lproj -lm
 int main(int argc, char** argv)
 {
+    (void)argc;
+    (void)argv;
+
+    GTimer *timer = g_timer_new();
+
+    for (guint npt=16384; npt<=4194304; npt*=4) {
+        // closed square ring of 1km (projected metre)
+        pt3   *ring = g_new(pt3, npt);
+        guint  side = (npt-1) / 4;
+        for (guint i=0; i<npt-1; ++i) {
+            guint  k = MIN(i / side, 3);
+            double t = (double)(i % side) / side;
+            ring[i].x = 1000.0 * ((0==k) ? t : (1==k) ? 1.0 : (2==k) ? 1.0-t : 0.0);
+            ring[i].y = 1000.0 * ((0==k) ? 0.0 : (1==k) ? t : (2==k) ? 1.0 : 1.0-t);
+            ring[i].z = 0.0;
+            // jitter every 4th point off the line (10m)
+            if (1 == (i & 3))
+                ring[i].y += ((0==k || 2==k) ? 10.0 : 0.0);
+        }
+        ring[npt-1] = ring[0];
+
+        g_timer_start(timer);
+        guint n = _delInLineSeg(npt, (double*)ring, 4);
+        g_timer_stop(timer);
 
-   return 1;
+        g_print("npt:%8u -> %8u  %10.3f msec\n", npt, n, g_timer_elapsed(timer, NULL) * 1000.0);
+
+        g_free(ring);
+    }
+
+    g_timer_destroy(timer);
+
+    return 0;
 }
-#endif  // 0
+#endif  // S57_MAIN_DELINLINE
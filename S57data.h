@@ -42,6 +42,11 @@
 // push Z in geo - use as a clip plane for LS() and LC()
 #define S57_OVERLAP_GEO_Z   10.0
 
+#ifdef S52_USE_LINE_LOD
+// LINE level of detail: 0 original, 1-5 IHO navigational purpose band Harbour to Overview
+#define S57_LOD_MAX          6
+#endif
+
 // internal geo enum used to link S52 to S57 geo
 // S57 object type have a PLib enum: P,L,A
 typedef enum S57_Obj_t {
@@ -167,6 +172,8 @@ S57_Obj_t S57_getObjtype(S57_geo *geo);
 // return S57 attribute value of the attribute name
 GString  *S57_getAttVal(S57_geo *geo, const char *attName);
 GString  *S57_getAttValALL(S57_geo *geo, const char *attName);
+// same as S57_getAttValALL() with attribute name allready interned (g_quark_from_string())
+GString  *S57_getAttValQ  (S57_geo *geo, GQuark attName);
 
 // set attribute name and value
 GData    *S57_setAtt(S57_geo *geo, const char *name, const char *val);
@@ -221,6 +228,8 @@ gboolean  S57_isPtInArea(S57_geo *geo, double x, double y);
 gboolean  S57_isPtInRing(guint npt, pt3 *pt, gboolean close, double x, double y);
 gboolean  S57_isPtInSet(S57_geo *geo, double x, double y);
 gboolean  S57_isPtOnLine(S57_geo *geoLine, double x, double y);
+// TRUE if a vertex or a segment of the ring/line is inside box x+-dx, y+-dy
+gboolean  S57_isPtNearRing(guint npt, pt3 *pt, double x, double y, double dx, double dy);
 //gboolean  S57_touchArea(S57_geo *geoArea, S57_geo *geo);
 
 guint     S57_getGeoSize(S57_geo *geo);
@@ -231,6 +240,27 @@ int       S57_addCentroid(S57_geo *geo, double  x, double  y);
 int       S57_getNextCent(S57_geo *geo, double *x, double *y);
 int       S57_hasCentroid(S57_geo *geo);
 
+// LS() VBO of a static line (XYZ + arc length) - 0 if none
+// stale: TRUE if the coord changed (re-projected, resized) since the VBO was set
+int       S57_setLineVBO(S57_geo *geo, guint vboID);
+guint     S57_getLineVBO(S57_geo *geo, gboolean *stale);
+// geo coord edited in place (mariner object) - no VBO
+int       S57_setGeoDyn (S57_geo *geo, gboolean dyn);
+gboolean  S57_getGeoDyn (S57_geo *geo);
+
+#ifdef S52_USE_LINE_LOD
+// LINE - Ramer-Douglas-Peucker simplification of the projected line, all level built
+// once projected (projection / load worker), dropped by S57_geo2prj()
+// FALSE if not a static line of at least 3 vertex (no LOD)
+int       S57_setGeoLOD (S57_geo *geo);
+// number of level (level 0 included): S57_LOD_MAX, or 1 if no LOD
+guint     S57_getGeoLODnbr(S57_geo *geo);
+// level 0 (or no LOD) is the original data of S57_getGeoData()
+int       S57_getGeoLOD (S57_geo *geo, guint level, guint *npt, double **ppt);
+// finest level whose tolerance is above the screen resolution (mpp: meter per pixel)
+guint     S57_getLODlevel(double mpp);
+#endif
+
 #ifdef S52_USE_SUPP_LINE_OVERLAP
 S57_geo  *S57_getEdgeOwner(S57_geo *geoEdge);
 S57_geo  *S57_setEdgeOwner(S57_geo *geoEdge, S57_geo *owner);
@@ -242,6 +272,21 @@ gchar    *S57_getRCIDstr(S57_geo *geo);
 
 #endif  // S52_USE_SUPP_LINE_OVERLAP
 
+#ifdef S52_USE_CELL_CACHE
+// flat record of a S57_geo (geo data, attributes, tessellated area) for the cell cache
+int       S57_geo2cache(S57_geo *geo, GByteArray *buf);
+S57_geo  *S57_cache2geo(const guchar **data, const guchar *end);
+#endif
+
+// packed R-tree of extent - bulk loaded, query return the index of the extent in the build array
+typedef struct _S57_rtree S57_rtree;
+#ifdef S52_USE_RTREE
+S57_rtree *S57_newRTree   (ObjExt_t  *ext, guint n);
+S57_rtree *S57_doneRTree  (S57_rtree *tree);
+guint      S57_getRTreeSize(S57_rtree *tree);
+guint      S57_queryRTree (S57_rtree *tree, ObjExt_t view, GArray *res);
+#endif
+
 // Note: CS call these where S57_geo is available (no S52_obj so can't move these call to PL)
 int       S57_setHighlight(S57_geo *geo, gboolean highlight);
 gboolean  S57_getHighlight(S57_geo *geo);
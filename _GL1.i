@@ -13,6 +13,13 @@
 #include "GL/glext.h"
 #include <GL/glu.h>
 
+#ifdef S52_USE_FRAME_STATS
+// count draw call / vertex (see S52_GL_getStat())
+static guint _nDrawCall = 0;
+static guint _nVertex   = 0;
+#define glDrawArrays(mode, first, count) (++_nDrawCall, _nVertex += (count), glDrawArrays(mode, first, count))
+#endif
+
 // add missing def for MINGW
 #ifdef _MINGW
 #define GL_ARRAY_BUFFER                   0x8892
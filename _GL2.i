@@ -26,6 +26,13 @@ typedef double GLdouble;
 typedef GLUtesselator GLUtesselatorObj;
 typedef GLUtesselator GLUtriangulatorObj;
 
+#ifdef S52_USE_FRAME_STATS
+// count draw call / vertex (see S52_GL_getStat())
+static guint _nDrawCall = 0;
+static guint _nVertex   = 0;
+#define glDrawArrays(mode, first, count) (++_nDrawCall, _nVertex += (count), glDrawArrays(mode, first, count))
+#endif
+
 ////////////////////////////////////////////////////////
 // forward decl
 static double      _getWorldGridRef(S52_obj *, double *, double *, double *, double *, double *, double *);
@@ -38,6 +45,7 @@ static int         _glMatrixDel(VP);
 static int         _pushScaletoPixel(int);
 static int         _popScaletoPixel(void);
 static GLubyte     _setFragAttrib(S52_Color *, gboolean);
+static int         _glColor4ub(GLubyte, GLubyte, GLubyte, GLubyte);
 static void        _glLineWidth(GLfloat);
 static void        _glPointSize(GLfloat);
 static inline void _checkError(const char *);
@@ -60,6 +68,8 @@ static int _GL_KHR_no_error     = FALSE;
 static GArray *_tessWorkBuf_d = NULL;
 // used to convert geo double to VBO float
 static GArray *_tessWorkBuf_f = NULL;
+// LS(): XYZ + arc length of each vertex (float) - line VBO and transient line
+static GArray *_lineWorkBuf_f = NULL;
 
 // glsl main
 static GLuint _programObject = 0;
@@ -81,6 +91,44 @@ static GLint _uPattGridY  = 0;
 static GLint _uPattW      = 0;
 static GLint _uPattH      = 0;
 
+static GLint _uStipW      = 0;  // LS() dash/dott: world length of the 1D pattern (0.0 - off)
+
+#ifdef S52_USE_PAL_IDX
+// color by palette index: all the palettes of the PLib in one texture (a row per palette)
+// and the color index + alpha of a vertex in aCIdx (constant via glVertexAttrib2f() or per-vertex)
+// so a palette switch is one uniform (uPalRow)
+#define PAL_TEX_W  64  // S52_COL_NUM (63) + TRANS
+#define PAL_TEX_H   8  // DAY_BRIGHT, DAY_BLACKBACK, DAY_WHITEBACK, DUSK, NIGHT, ..
+static GLuint  _palTexID    = 0;
+static guint   _palStamp    = 0;   // S52_PL_getPalStamp() of the colors in _palTexID
+static GLubyte _palTexRGBA[PAL_TEX_W * PAL_TEX_H * 4];
+static GLint   _uSamplerPal = 0;
+static GLint   _uPalRow     = 0;   // texture V of the current palette
+static GLint   _aCIdx       = 0;   // x: texture U of color (< 0: use uColor), y: alpha
+#endif
+
+#ifdef S52_USE_SY_INST
+// SY() instancing: point symbol queued per symbol definition (S52_DListData)
+// then drawn per display priority with the symbol VBO and an instance attribute
+// aInst: world x, y, cos/sin of rotation - one draw per primitive of each symbol
+// Note: GLES2 without GL_EXT/ANGLE_instanced_arrays draw each instance with a constant aInst
+typedef struct _SYinst {
+    S52_DListData *DListData;
+    int            ok;      // FALSE if symbol has a _TRANSLATE prim - drawn by _glCallList()
+    GArray        *inst;    // GLfloat x 4 per instance
+} _SYinst;
+static GPtrArray  *_SYinstList = NULL;  // _SYinst
+static GHashTable *_SYinstIdx  = NULL;  // S52_DListData --> _SYinst
+static guint       _SYinstN    = 0;     // number of instance queued
+static GLuint      _SYinstVBO  = 0;
+static GLint       _uInstOn    = 0;
+static GLint       _uInstScale = 0;     // symbol unit (0.01 mm) to world, Y flip
+static GLint       _aInst      = 0;
+static int         _GL_EXT_instanced_arrays = FALSE;
+static PFNGLDRAWARRAYSINSTANCEDEXTPROC _glDrawArraysInstancedEXT = NULL;
+static PFNGLVERTEXATTRIBDIVISOREXTPROC _glVertexAttribDivisorEXT = NULL;
+#endif
+
 // glsl varying
 static GLint _aPosition   = 0;
 static GLint _aUV         = 0;
@@ -179,6 +227,16 @@ static const GLubyte _dashpa_mask_bits[4] = {     // 4 x 8 bits = 32 bits
 // other pattern are created using FBO
 static GLuint         _fboID = 0;
 
+#ifdef S52_USE_AP_CACHE
+// AP() tile texture shared by all obj, key: "PANM:tileWpx:tileHpx:stagOffsetPix" --> texID
+// Note: a tile is a mask, color come from _setFragAttrib(), so palette is not part of the key
+// Note: tile size in pixel depend on dot pitch only, flush all on dot pitch change
+static GHashTable    *_APtexCache   = NULL;
+static GString       *_APtexKey     = NULL;
+static double         _APtexDotpitX = 0.0;
+static double         _APtexDotpitY = 0.0;
+#endif
+
 
 //---- PATTERN GL2 / GLES2 -----------------------------------------------------------
 //
@@ -237,6 +295,31 @@ typedef struct {
 static GLuint  _freetype_gl_textureID = 0;
 static GArray *_freetype_gl_buffer    = NULL;
 
+#ifdef S52_USE_TXT_SDF
+// one signed distance field font serve every bsize / dot pitch / rotation
+// glyph are scaled in _fill_freetype_gl_buffer(), edge is a smoothstep() in GLSL
+#define SDF_FONT_PX  32  // raster size of the SDF font
+#define SDF_SPREAD    4  // distance field padding (pixel at SDF_FONT_PX)
+static double _freetype_gl_sdfScale[S52_MAX_FONT] = {1.0, 1.0, 1.0, 1.0};  // bsize px / SDF_FONT_PX
+static float  _sdfW  = 0.0;  // half width of the edge in distance unit (~ half a pixel)
+static GLint  _uSdfW = 0;
+#endif
+
+#ifdef S52_USE_TXT_BATCH
+// chart text of a cell (S52_GL_DRAW) accumulated in world coord then drawn
+// from one stream VBO - one glDrawArrays() per color (atlas is shared)
+typedef struct _TXTbin {
+    S52_Color  color;      // copy - trans of text is per obj
+    gboolean   highlight;
+    gboolean   shadow;     // S52_USE_TXT_SHADOW - drawn first
+    GArray    *vertex;     // _freetype_gl_vertex_t in world coord
+} _TXTbin;
+static GPtrArray  *_txtBins     = NULL;  // _TXTbin
+static GHashTable *_txtGlyph    = NULL;  // static text VBO id --> glyph (_freetype_gl_vertex_t) CPU copy
+static guint       _txtBatchN   = 0;     // number of vertex queued
+static GLuint      _txtBatchVBO = 0;
+#endif
+
 #define LF  '\r'   // Line Feed
 #define TB  '\t'   // Tabulation
 #define NL  '\n'   // New Line
@@ -270,6 +353,27 @@ static int       _d2f(GArray *tessWorkBuf_f, unsigned int npt, double *ppt)
     return TRUE;
 }
 
+static int       _d2fArc(GArray *lineWorkBuf_f, unsigned int npt, double *ppt)
+// convert line to float XYZ + arc length (world) of each vertex, for LS() stipple in GLSL
+{
+    double arc = 0.0;
+
+    g_array_set_size(lineWorkBuf_f, 0);
+
+    for (guint i=0; i<npt; ++i) {
+        if (0 < i) {
+            double dx = ppt[0] - ppt[-3];
+            double dy = ppt[1] - ppt[-2];
+            arc += sqrt(dx*dx + dy*dy);
+        }
+
+        float f[4] = {ppt[0], ppt[1], 0.0, arc};  // flush S57_OVERLAP_GEO_Z
+        g_array_append_val(lineWorkBuf_f, f);
+        ppt += 3;
+    }
+    return TRUE;
+}
+
 static int       _init_freetype_gl(void)
 {
     const wchar_t   *cache    = L" !\"#$%&'()*+,-./0123456789:;<=>?"
@@ -282,6 +386,8 @@ static int       _init_freetype_gl(void)
     if (NULL == _freetype_gl_atlas) {
 #ifdef S52_USE_GLSC2
         _freetype_gl_atlas = texture_atlas_new(512, 512, 3);    // GL_RGB in GLSC2 - code change in GLSL
+#elif defined(S52_USE_TXT_SDF)
+        _freetype_gl_atlas = texture_atlas_new(512, 256, 1);    // alpha only  - one font
 #else
         _freetype_gl_atlas = texture_atlas_new(512, 512, 1);    // alpha only  - not in GLSC2
 #endif
@@ -294,6 +400,16 @@ static int       _init_freetype_gl(void)
     _checkError("_init_freetype_gl() -0-");
 
     // FIXME: overkill!
+#ifdef S52_USE_TXT_SDF
+    // all bsize share the SDF font
+    if (NULL != _freetype_gl_font[0]) {
+        texture_font_delete(_freetype_gl_font[0]);
+        _freetype_gl_font[0] = NULL;
+        _freetype_gl_font[1] = NULL;
+        _freetype_gl_font[2] = NULL;
+        _freetype_gl_font[3] = NULL;
+    }
+#endif
     if (NULL != _freetype_gl_font[0]) {
         texture_font_delete(_freetype_gl_font[0]);
         texture_font_delete(_freetype_gl_font[1]);
@@ -324,6 +440,28 @@ static int       _init_freetype_gl(void)
 
     //PRINTF("DEBUG: basePtSz = %i, dotp mm=%f\n", basePtSz, _dotpitch_mm_y);
 
+#ifdef S52_USE_TXT_SDF
+    _freetype_gl_font[0] = texture_font_new(_freetype_gl_atlas, _freetype_gl_fontfilename, SDF_FONT_PX);
+    if (NULL == _freetype_gl_font[0]) {
+        PRINTF("WARNING: texture_font_new() failed\n");
+        g_assert(0);
+        return FALSE;
+    }
+    _freetype_gl_font[0]->sdf_spread = SDF_SPREAD;
+    _freetype_gl_font[1] = _freetype_gl_font[0];
+    _freetype_gl_font[2] = _freetype_gl_font[0];
+    _freetype_gl_font[3] = _freetype_gl_font[0];
+
+    // same steps as the bitmap fonts
+    for (int i=0; i<S52_MAX_FONT; ++i)
+        _freetype_gl_sdfScale[i] = (basePtSz + 6*i) / (double)SDF_FONT_PX;
+
+    // distance unit per pixel: 0.5/SDF_SPREAD at scale 1 - half a pixel at mid scale
+    _sdfW = 0.25 / (SDF_SPREAD * (_freetype_gl_sdfScale[1] + _freetype_gl_sdfScale[2]) / 2.0);
+
+    texture_font_load_glyphs(_freetype_gl_font[0], cache);
+    _checkError("_init_freetype_gl() -1-");
+#else
     _freetype_gl_font[0] = texture_font_new(_freetype_gl_atlas, _freetype_gl_fontfilename, basePtSz +  0);
     _freetype_gl_font[1] = texture_font_new(_freetype_gl_atlas, _freetype_gl_fontfilename, basePtSz +  6);
     _freetype_gl_font[2] = texture_font_new(_freetype_gl_atlas, _freetype_gl_fontfilename, basePtSz + 12);
@@ -341,6 +479,7 @@ static int       _init_freetype_gl(void)
     texture_font_load_glyphs(_freetype_gl_font[1], cache);
     texture_font_load_glyphs(_freetype_gl_font[2], cache);
     texture_font_load_glyphs(_freetype_gl_font[3], cache);
+#endif  // S52_USE_TXT_SDF
 
     _checkError("_init_freetype_gl() -2-");
 
@@ -369,8 +508,18 @@ static GArray   *_fill_freetype_gl_buffer(GArray *ftglBuf, const char *str, unsi
 // fill buffer with triangles strip, W/H can be NULL
 // experimental: smaller text size if second line
 {
+#ifdef S52_USE_TXT_SDF
+    // glyph metric are at SDF_FONT_PX, padded by SDF_SPREAD
+    GLfloat pen_x = 0;
+    GLfloat pen_y = 0;
+#define FTGL_SC(bsize) ((GLfloat)_freetype_gl_sdfScale[bsize])
+#define FTGL_PAD       (2*SDF_SPREAD)
+#else
     int   pen_x = 0;
     int   pen_y = 0;
+#define FTGL_SC(bsize) (1)
+#define FTGL_PAD       (0)
+#endif
     int   nl    = FALSE;
     glong len   = g_utf8_strlen(str, -1);
 
@@ -398,7 +547,7 @@ static GArray   *_fill_freetype_gl_buffer(GArray *ftglBuf, const char *str, unsi
             bsize = (0<bsize) ? bsize-1 : bsize;
             texture_glyph_t *glyph = texture_font_get_glyph(_freetype_gl_font[bsize], 'A');
             pen_x =  0;
-            pen_y = (NULL!=glyph) ? -(glyph->height+5) : 10 ;
+            pen_y = (NULL!=glyph) ? -(((int)glyph->height-FTGL_PAD)*FTGL_SC(bsize)+5) : 10 ;
             nl    = TRUE;
 
             continue;
@@ -406,15 +555,16 @@ static GArray   *_fill_freetype_gl_buffer(GArray *ftglBuf, const char *str, unsi
 
         // experimental: augmente kerning if second line
         if (TRUE == nl) {
-            pen_x += texture_glyph_get_kerning(glyph, unic);
+            // kerning is at the glyph metric size (SDF_FONT_PX)
+            pen_x += texture_glyph_get_kerning(glyph, unic) * FTGL_SC(bsize);
             pen_x++;
         }
 
-        GLfloat x0 = pen_x + glyph->offset_x;
-        GLfloat y0 = pen_y + glyph->offset_y;
+        GLfloat x0 = pen_x + glyph->offset_x * FTGL_SC(bsize);
+        GLfloat y0 = pen_y + glyph->offset_y * FTGL_SC(bsize);
 
-        GLfloat x1 = x0    + glyph->width;
-        GLfloat y1 = y0    - glyph->height;    // Y is down, so flip glyph
+        GLfloat x1 = x0    + glyph->width  * FTGL_SC(bsize);
+        GLfloat y1 = y0    - glyph->height * FTGL_SC(bsize);    // Y is down, so flip glyph
         //GLfloat y1 = y0    - (glyph->height+1);  // Y is down, so flip glyph
                                                  // +1 check this, some device clip the top row
         GLfloat s0 = glyph->s0;
@@ -440,15 +590,19 @@ static GArray   *_fill_freetype_gl_buffer(GArray *ftglBuf, const char *str, unsi
         ftglBuf = g_array_append_vals(ftglBuf, &vertices[0], 3);
         ftglBuf = g_array_append_vals(ftglBuf, &vertices[3], 3);
 
-        pen_x += glyph->advance_x;
-        pen_y += glyph->advance_y;
+        pen_x += glyph->advance_x * FTGL_SC(bsize);
+        pen_y += glyph->advance_y * FTGL_SC(bsize);
 
         // tally whole string size (what with NL)
         if (NULL!=strWpx && NULL!=strHpx) {
-            *strWpx += glyph->width;
-            *strHpx  = (*strHpx>glyph->height)? *strHpx : glyph->height;
+            double w = ((int)glyph->width  - FTGL_PAD) * FTGL_SC(bsize);
+            double h = ((int)glyph->height - FTGL_PAD) * FTGL_SC(bsize);
+            *strWpx += w;
+            *strHpx  = (*strHpx>h)? *strHpx : h;
         }
     }
+#undef FTGL_SC
+#undef FTGL_PAD
 
     //PRINTF("DEBUG: h/w px: %f %f\n", h_px, w_px);
 
@@ -796,6 +950,9 @@ static int       _renderTXTAA_gl2(double x, double y, GLfloat *data, guint len)
 
     // turn ON 'sampler2d'
     glUniform1f(_uTextOn, 1.0);
+#ifdef S52_USE_TXT_SDF
+    glUniform1f(_uSdfW, _sdfW);
+#endif
 
     glBindTexture(GL_TEXTURE_2D, _freetype_gl_atlas->id);
 
@@ -826,6 +983,142 @@ static int       _renderTXTAA_gl2(double x, double y, GLfloat *data, guint len)
     return TRUE;
 }
 
+#ifdef S52_USE_TXT_BATCH
+static int       _TXTbatchAdd(S52_Color *color, gboolean highlight, gboolean shadow, GArray *glyph, double x, double y)
+// transform glyph (pixel) to world as _renderTXTAA_gl2() does, append to the bin of this color
+{
+    if (NULL == _txtBins)
+        _txtBins = g_ptr_array_new();
+
+    _TXTbin *bin = NULL;
+    for (guint i=0; i<_txtBins->len; ++i) {
+        _TXTbin *b = (_TXTbin *)g_ptr_array_index(_txtBins, i);
+        if ((highlight==b->highlight) && (shadow==b->shadow) &&
+            (color->fragAtt.trans==b->color.fragAtt.trans) && (0==g_strcmp0(color->colName, b->color.colName))) {
+            bin = b;
+            break;
+        }
+    }
+    if (NULL == bin) {
+        bin            = g_new0(_TXTbin, 1);
+        bin->highlight = highlight;
+        bin->shadow    = shadow;
+        bin->vertex    = g_array_new(FALSE, FALSE, sizeof(_freetype_gl_vertex_t));
+        g_ptr_array_add(_txtBins, bin);
+    }
+    // color can change between cycle (palette)
+    bin->color = *color;
+
+    // horizontal text
+    double a = -_view.north * G_PI / 180.0;
+    double c = cos(a);
+    double s = sin(a);
+
+    guint n = bin->vertex->len;
+    g_array_set_size(bin->vertex, n + glyph->len);
+    _freetype_gl_vertex_t *src = (_freetype_gl_vertex_t *)glyph->data;
+    _freetype_gl_vertex_t *dst = &g_array_index(bin->vertex, _freetype_gl_vertex_t, n);
+    for (guint i=0; i<glyph->len; ++i, ++src, ++dst) {
+        *dst   = *src;
+        dst->x = x + _scalex * (src->x*c - src->y*s);
+        dst->y = y + _scaley * (src->x*s + src->y*c);
+    }
+    _txtBatchN += glyph->len;
+
+    return TRUE;
+}
+
+static int       _TXTbatchFlush(void)
+// upload all bins, draw shadow first then text
+{
+    if (0 == _txtBatchN)
+        return FALSE;
+
+    if (0 == _txtBatchVBO)
+        glGenBuffers(1, &_txtBatchVBO);
+
+    glBindBuffer(GL_ARRAY_BUFFER, _txtBatchVBO);
+    glBufferData(GL_ARRAY_BUFFER, _txtBatchN * sizeof(_freetype_gl_vertex_t), NULL, GL_STREAM_DRAW);
+
+    GArray *first = g_array_sized_new(FALSE, FALSE, sizeof(GLint), _txtBins->len);
+    GLint   n     = 0;
+    for (guint i=0; i<_txtBins->len; ++i) {
+        _TXTbin *bin = (_TXTbin *)g_ptr_array_index(_txtBins, i);
+        g_array_append_val(first, n);
+        if (0 < bin->vertex->len) {
+            glBufferSubData(GL_ARRAY_BUFFER, n * sizeof(_freetype_gl_vertex_t),
+                            bin->vertex->len * sizeof(_freetype_gl_vertex_t), bin->vertex->data);
+            n += bin->vertex->len;
+        }
+    }
+
+    glEnableVertexAttribArray(_aPosition);
+    glVertexAttribPointer    (_aPosition, 3, GL_FLOAT, GL_FALSE, sizeof(_freetype_gl_vertex_t), BUFFER_OFFSET(0));
+    glEnableVertexAttribArray(_aUV);
+    glVertexAttribPointer    (_aUV,       2, GL_FLOAT, GL_FALSE, sizeof(_freetype_gl_vertex_t), BUFFER_OFFSET(sizeof(float)*3));
+
+    glUniform1f(_uTextOn, 1.0);
+#ifdef S52_USE_TXT_SDF
+    glUniform1f(_uSdfW, _sdfW);
+#endif
+    glBindTexture(GL_TEXTURE_2D, _freetype_gl_atlas->id);
+
+    _glUniformMatrix4fv_uModelview();
+
+    for (int pass=0; pass<2; ++pass) {
+        for (guint i=0; i<_txtBins->len; ++i) {
+            _TXTbin *bin = (_TXTbin *)g_ptr_array_index(_txtBins, i);
+            if ((0==bin->vertex->len) || ((0==pass) != bin->shadow))
+                continue;
+
+            _setFragAttrib(&bin->color, bin->highlight);
+            glDrawArrays(GL_TRIANGLES, g_array_index(first, GLint, i), bin->vertex->len);
+
+            g_array_set_size(bin->vertex, 0);
+        }
+    }
+    g_array_free(first, TRUE);
+    _txtBatchN = 0;
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUniform1f(_uTextOn, 0.0);
+
+    glDisableVertexAttribArray(_aUV);
+    glDisableVertexAttribArray(_aPosition);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    _checkError("_TXTbatchFlush()");
+
+    return TRUE;
+}
+
+static int       _TXTbatchDone(void)
+{
+    if (NULL != _txtBins) {
+        for (guint i=0; i<_txtBins->len; ++i) {
+            _TXTbin *bin = (_TXTbin *)g_ptr_array_index(_txtBins, i);
+            g_array_free(bin->vertex, TRUE);
+            g_free(bin);
+        }
+        g_ptr_array_free(_txtBins, TRUE);
+        _txtBins = NULL;
+    }
+
+    if (NULL != _txtGlyph) {
+        g_hash_table_destroy(_txtGlyph);
+        _txtGlyph = NULL;
+    }
+
+    if (0 != _txtBatchVBO) {
+        glDeleteBuffers(1, &_txtBatchVBO);
+        _txtBatchVBO = 0;
+    }
+    _txtBatchN = 0;
+
+    return TRUE;
+}
+#endif  // S52_USE_TXT_BATCH
+
 typedef unsigned char u8;
 #ifdef S52_USE_GLSC2
 typedef void (GL_APIENTRYP PFNGLREADNPIXELSKHRPROC) (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format, GLenum type, GLsizei bufSize, void *data);
@@ -843,6 +1136,71 @@ static PFNGLPROGRAMBINARYOESPROC          _glProgramBinaryOES       = NULL;
 static PFNGLTEXSTORAGE2DEXTPROC           _glTexStorage2DEXT        = NULL;
 #endif
 
+#if defined(S52_USE_FRAME_STATS) && !defined(S52_USE_GLSC2)
+// GPU time - GL_EXT_disjoint_timer_query
+static int _GL_EXT_disjoint_timer_query = FALSE;
+static PFNGLGENQUERIESEXTPROC             _glGenQueriesEXT          = NULL;
+static PFNGLDELETEQUERIESEXTPROC          _glDeleteQueriesEXT       = NULL;
+static PFNGLBEGINQUERYEXTPROC             _glBeginQueryEXT          = NULL;
+static PFNGLENDQUERYEXTPROC               _glEndQueryEXT            = NULL;
+static PFNGLGETQUERYOBJECTUIVEXTPROC      _glGetQueryObjectuivEXT   = NULL;
+static PFNGLGETQUERYOBJECTUI64VEXTPROC    _glGetQueryObjectui64vEXT = NULL;
+
+static GLuint _gpuQuery  [2] = {0,     0    };  // [0]: S52_GL_DRAW, [1]: S52_GL_LAST
+static int    _gpuQueryOn[2] = {FALSE, FALSE};  // query started this cycle
+static int    _gpuPending[2] = {FALSE, FALSE};  // result not collected
+static double _gpuMsec   [2] = {-1.0,  -1.0 };
+
+static int       _gpuTimerBeg(int i)
+// collect previous result (no stall) then start timing this cycle
+{
+    if (FALSE==_GL_EXT_disjoint_timer_query || NULL==_glBeginQueryEXT)
+        return FALSE;
+
+    if (0 == _gpuQuery[i])
+        _glGenQueriesEXT(1, &_gpuQuery[i]);
+
+    if (TRUE == _gpuPending[i]) {
+        GLuint avail = GL_FALSE;
+        _glGetQueryObjectuivEXT(_gpuQuery[i], GL_QUERY_RESULT_AVAILABLE_EXT, &avail);
+        // GPU lag - skip timing this cycle
+        if (GL_FALSE == avail)
+            return FALSE;
+
+        // result meaningless if GPU was disjoint (power state, ..)
+        GLint disjoint = GL_FALSE;
+        glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+        if (GL_FALSE == disjoint) {
+            GLuint64 nsec = 0;
+            _glGetQueryObjectui64vEXT(_gpuQuery[i], GL_QUERY_RESULT_EXT, &nsec);
+            _gpuMsec[i] = (double)nsec / 1000000.0;
+        }
+        _gpuPending[i] = FALSE;
+    }
+
+    _glBeginQueryEXT(GL_TIME_ELAPSED_EXT, _gpuQuery[i]);
+    _gpuQueryOn[i] = TRUE;
+
+    _checkError("_gpuTimerBeg()");
+
+    return TRUE;
+}
+
+static int       _gpuTimerEnd(int i)
+{
+    if (FALSE == _gpuQueryOn[i])
+        return FALSE;
+
+    _glEndQueryEXT(GL_TIME_ELAPSED_EXT);
+    _gpuQueryOn[i] = FALSE;
+    _gpuPending[i] = TRUE;
+
+    _checkError("_gpuTimerEnd()");
+
+    return TRUE;
+}
+#endif  // S52_USE_FRAME_STATS
+
 #ifdef S52_USE_EGL
 static int       _loadProcEXT()
 {
@@ -892,6 +1250,33 @@ static int       _loadProcEXT()
 
     _glTexStorage2DEXT =      (PFNGLTEXSTORAGE2DEXTPROC)     eglGetProcAddress("glTexStorage2DEXT");
     PRINTF("DEBUG: eglGetProcAddress(glTexStorage2DEXT)      %s\n",     (NULL==_glTexStorage2DEXT)?"FAILED":"OK");
+
+#ifdef S52_USE_FRAME_STATS
+    _glGenQueriesEXT          = (PFNGLGENQUERIESEXTPROC)          eglGetProcAddress("glGenQueriesEXT");
+    _glDeleteQueriesEXT       = (PFNGLDELETEQUERIESEXTPROC)       eglGetProcAddress("glDeleteQueriesEXT");
+    _glBeginQueryEXT          = (PFNGLBEGINQUERYEXTPROC)          eglGetProcAddress("glBeginQueryEXT");
+    _glEndQueryEXT            = (PFNGLENDQUERYEXTPROC)            eglGetProcAddress("glEndQueryEXT");
+    _glGetQueryObjectuivEXT   = (PFNGLGETQUERYOBJECTUIVEXTPROC)   eglGetProcAddress("glGetQueryObjectuivEXT");
+    _glGetQueryObjectui64vEXT = (PFNGLGETQUERYOBJECTUI64VEXTPROC) eglGetProcAddress("glGetQueryObjectui64vEXT");
+    if (NULL==_glGenQueriesEXT || NULL==_glDeleteQueriesEXT || NULL==_glBeginQueryEXT || NULL==_glEndQueryEXT ||
+        NULL==_glGetQueryObjectuivEXT || NULL==_glGetQueryObjectui64vEXT) {
+        _glBeginQueryEXT = NULL;
+    }
+    PRINTF("DEBUG: eglGetProcAddress(glBeginQueryEXT, ..)    %s\n",     (NULL==_glBeginQueryEXT)?"FAILED":"OK");
+#endif
+
+#ifdef S52_USE_SY_INST
+    _glDrawArraysInstancedEXT = (PFNGLDRAWARRAYSINSTANCEDEXTPROC) eglGetProcAddress("glDrawArraysInstancedEXT");
+    _glVertexAttribDivisorEXT = (PFNGLVERTEXATTRIBDIVISOREXTPROC) eglGetProcAddress("glVertexAttribDivisorEXT");
+    if (NULL==_glDrawArraysInstancedEXT || NULL==_glVertexAttribDivisorEXT) {
+        _glDrawArraysInstancedEXT = (PFNGLDRAWARRAYSINSTANCEDEXTPROC) eglGetProcAddress("glDrawArraysInstancedANGLE");
+        _glVertexAttribDivisorEXT = (PFNGLVERTEXATTRIBDIVISOREXTPROC) eglGetProcAddress("glVertexAttribDivisorANGLE");
+    }
+    if (NULL==_glDrawArraysInstancedEXT || NULL==_glVertexAttribDivisorEXT) {
+        _glDrawArraysInstancedEXT = NULL;
+    }
+    PRINTF("DEBUG: eglGetProcAddress(glDrawArraysInstanced, ..) %s\n",  (NULL==_glDrawArraysInstancedEXT)?"FAILED":"OK");
+#endif
 #endif
 
     return TRUE;
@@ -1088,6 +1473,78 @@ static int       _initTexture(void)
 }
 
 #if !defined(S52_USE_GLSC2)
+#ifdef S52_USE_PAL_IDX
+static int       _palTexUpdate(void)
+// (re)load PLib palettes in texture unit 1 if a color changed, then select the current palette
+{
+    guint stamp = S52_PL_getPalStamp();
+
+    glActiveTexture(GL_TEXTURE1);
+
+    if ((0==_palTexID) || (stamp!=_palStamp)) {
+        guint nPal = MIN(S52_PL_getPalTableSz(), PAL_TEX_H);
+
+        memset(_palTexRGBA, 0, sizeof(_palTexRGBA));
+        for (guint p=0; p<nPal; ++p) {
+            for (guint i=0; i<PAL_TEX_W; ++i) {
+                S52_Color *c = S52_PL_getPalColor(p, i);
+                if (NULL == c)
+                    continue;
+
+                GLubyte *rgba = &_palTexRGBA[(p*PAL_TEX_W + i) * 4];
+                rgba[0] = c->R;
+                rgba[1] = c->G;
+                rgba[2] = c->B;
+                rgba[3] = 255;
+            }
+        }
+
+        if (0 == _palTexID) {
+            glGenTextures(1, &_palTexID);
+            glBindTexture(GL_TEXTURE_2D, _palTexID);
+#ifdef S52_USE_GLSC2
+            // one level, sized format (SC2 has no unsized one)
+            glTexStorage2D (GL_TEXTURE_2D, 1, GL_RGBA8, PAL_TEX_W, PAL_TEX_H);
+#else
+            glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, PAL_TEX_W, PAL_TEX_H, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+#endif
+            // one texel per color, no filtering
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,     GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,     GL_CLAMP_TO_EDGE);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        } else {
+            glBindTexture(GL_TEXTURE_2D, _palTexID);
+        }
+
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, PAL_TEX_W, PAL_TEX_H, GL_RGBA, GL_UNSIGNED_BYTE, _palTexRGBA);
+
+        _palStamp = stamp;
+
+        _checkError("_palTexUpdate() -load-");
+    } else {
+        glBindTexture(GL_TEXTURE_2D, _palTexID);
+    }
+
+    glActiveTexture(GL_TEXTURE0);
+
+    glUniform1i(_uSamplerPal, 1);
+    // palette switch
+    glUniform1f(_uPalRow, ((int)S52_MP_get(S52_MAR_COLOR_PALETTE) + 0.5) / PAL_TEX_H);
+
+    return TRUE;
+}
+
+static int       _glColorPal(S52_Color *c)
+// color from the palette texture - alpha from trans
+{
+    GLfloat alpha = (4 - (c->fragAtt.trans - '0')) * TRNSP_FAC_GLES2;
+    glVertexAttrib2f(_aCIdx, (c->fragAtt.cidx + 0.5) / PAL_TEX_W, alpha);
+
+    return TRUE;
+}
+#endif  // S52_USE_PAL_IDX
+
 static int       _saveShaderBin(GLuint programObject)
 // Save a GLSL shader bin into a file
 {
@@ -1277,10 +1734,20 @@ static GLuint    _compShaderSrc(GLuint programObject)
         "uniform   float uPattGridY;                                    \n"
         "uniform   float uPattW;                                        \n"
         "uniform   float uPattH;                                        \n"
+        "uniform   float uStipW;                                        \n"
+#ifdef S52_USE_SY_INST
+        "uniform   float uInstOn;                                       \n"
+        "uniform   vec2  uInstScale;                                    \n"
+        "attribute vec4  aInst;                                         \n"
+#endif
 
         "attribute vec2  aUV;                                           \n"
         "attribute vec4  aPosition;                                     \n"
         "attribute float aAlpha;                                        \n"
+#ifdef S52_USE_PAL_IDX
+        "attribute vec2  aCIdx;                                         \n"
+        "varying   vec2  v_cidx;                                        \n"
+#endif
 
         "varying   vec2  v_texCoord;                                    \n"
         "varying   vec4  v_acolor;                                      \n"
@@ -1290,15 +1757,32 @@ static GLuint    _compShaderSrc(GLuint programObject)
         "void main(void)                                                \n"
         "{                                                              \n"
         "    v_alpha      = aAlpha;                                     \n"
+#ifdef S52_USE_PAL_IDX
+        "    v_cidx       = aCIdx;                                      \n"
+#endif
         "    gl_PointSize = uPointSize;                                 \n"
+#ifdef S52_USE_SY_INST
+        "    vec4 pos = aPosition;                                      \n"
+        "    if (1.0 == uInstOn) {                                      \n"
+        "        vec2 r = vec2(aPosition.x*aInst.z - aPosition.y*aInst.w,   \n"
+        "                      aPosition.x*aInst.w + aPosition.y*aInst.z);  \n"
+        "        pos.xy = aInst.xy + r * uInstScale;                    \n"
+        "    }                                                          \n"
+        "    gl_Position  = uProjection * uModelview * pos;             \n"
+#else
         "    gl_Position  = uProjection * uModelview * aPosition;       \n"
+#endif
         "    if (1.0 == uPattOn) {                                      \n"
 //        "        v_texCoord.x = (aPosition.x - uPattGridX) / uPattW;    \n"
 //        "        v_texCoord.y = (aPosition.y - uPattGridY) / uPattH;    \n"
         "        v_texCoord.x = (uPattGridX - aPosition.x) / uPattW;    \n"
         "        v_texCoord.y = (uPattGridY - aPosition.y) / uPattH;    \n"
         "    } else {                                                   \n"
-        "        v_texCoord = aUV;                                      \n"
+        "        if (0.0 < uStipW) {                                    \n"
+        "            v_texCoord = vec2(aUV.x / uStipW, 0.5);            \n"
+        "        } else {                                               \n"
+        "            v_texCoord = aUV;                                  \n"
+        "        }                                                      \n"
         "    }                                                          \n"
         "}                                                              \n";
 
@@ -1323,12 +1807,27 @@ static GLuint    _compShaderSrc(GLuint programObject)
         "uniform float     uGlowOn;                 \n"
 
         "uniform vec4      uColor;                  \n"
+#ifdef S52_USE_TXT_SDF
+        "uniform float     uSdfW;                   \n"
+#endif
+#ifdef S52_USE_PAL_IDX
+        "uniform sampler2D uSamplerPal;             \n"
+        "uniform float     uPalRow;                 \n"
+        "varying vec2      v_cidx;                  \n"
+#endif
 
         "varying vec2      v_texCoord;              \n"
         "varying float     v_alpha;                 \n"
 
         "void main(void)                            \n"
         "{                                          \n"
+        "    vec4 color = uColor;                   \n"
+#ifdef S52_USE_PAL_IDX
+        "    if (0.0 <= v_cidx.x) {                 \n"
+        "        color.rgb = texture2D(uSamplerPal, vec2(v_cidx.x, uPalRow)).rgb; \n"
+        "        color.a   = v_cidx.y;              \n"
+        "    }                                      \n"
+#endif
         "    if (1.0 == uBlitOn) {                  \n"
         "        gl_FragColor = texture2D(uSampler2d0, v_texCoord);               \n"
 //        "        gl_FragColor.rgb = texture2D(uSampler2d0, v_texCoord).rgb;               \n"
@@ -1341,14 +1840,18 @@ static GLuint    _compShaderSrc(GLuint programObject)
 #ifdef S52_USE_GLSC2
         // GLSC2 has no GL_ALPHA in freetype-gl/texture_atlas_new() use GL_RED
         "            gl_FragColor.a   = texture2D(uSampler2d0, v_texCoord).r;                                \n"
+#elif defined(S52_USE_TXT_SDF)
+        // distance field: 0.5 on the glyph edge
+        "            float d = texture2D(uSampler2d0, v_texCoord).a;                                         \n"
+        "            gl_FragColor.a   = smoothstep(0.5 - uSdfW, 0.5 + uSdfW, d);                            \n"
 #else
         "            gl_FragColor.a   = texture2D(uSampler2d0, v_texCoord).a;                                \n"
 #endif
-        "            gl_FragColor.rgb = uColor.rgb;                              \n"
+        "            gl_FragColor.rgb = color.rgb;                               \n"
         "        } else {                                                        \n"
         "            if (1.0 == uPattOn) {                                       \n"
         "                gl_FragColor = texture2D(uSampler2d0, v_texCoord);       \n"
-        "                gl_FragColor.rgb = uColor.rgb;                          \n"
+        "                gl_FragColor.rgb = color.rgb;                           \n"
         "            } else {                                                    \n"
 #ifdef S52_USE_AFGLOW
         "                if (0.0 < uGlowOn) {                                    \n"
@@ -1356,13 +1859,13 @@ static GLuint    _compShaderSrc(GLuint programObject)
         "                    if (0.5 < dist) {                                   \n"
         "                        discard;                                        \n"
         "                    } else {                                            \n"
-        "                        gl_FragColor   = uColor;                        \n"
+        "                        gl_FragColor   = color;                         \n"
         "                        gl_FragColor.a = v_alpha;                       \n"
         "                    }                                                   \n"
         "                } else                                                  \n"
 #endif
         "                {                          \n"
-        "                    gl_FragColor = uColor; \n"
+        "                    gl_FragColor = color;  \n"
         "                }                          \n"
         "            }                              \n"
         "        }                                  \n"
@@ -1396,6 +1899,11 @@ static GLuint    _compShaderSrc(GLuint programObject)
 
     glAttachShader(programObject, vertexShader);
     glAttachShader(programObject, fragmentShader);
+
+#if defined(S52_USE_PAL_IDX) || defined(S52_USE_SY_INST)
+    // aCIdx / aInst is often a constant (array disabled) - keep it off attribute 0 (desktop GL)
+    glBindAttribLocation(programObject, 0, "aPosition");
+#endif
     _checkError("_compShaderSrc() -1.1-");
 
 #define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
@@ -1436,6 +1944,12 @@ static GLuint    _bindAttrib(GLuint programObject)
     _aPosition   = glGetAttribLocation(programObject, "aPosition");
     _aUV         = glGetAttribLocation(programObject, "aUV");
     _aAlpha      = glGetAttribLocation(programObject, "aAlpha");
+#ifdef S52_USE_PAL_IDX
+    _aCIdx       = glGetAttribLocation(programObject, "aCIdx");
+#endif
+#ifdef S52_USE_SY_INST
+    _aInst       = glGetAttribLocation(programObject, "aInst");
+#endif
 
     return programObject;
 }
@@ -1459,6 +1973,20 @@ static GLuint    _bindUnifrom(GLuint programObject)
     _uPattW      = glGetUniformLocation(programObject, "uPattW");
     _uPattH      = glGetUniformLocation(programObject, "uPattH");
 
+    _uStipW      = glGetUniformLocation(programObject, "uStipW");
+
+#ifdef S52_USE_PAL_IDX
+    _uSamplerPal = glGetUniformLocation(programObject, "uSamplerPal");
+    _uPalRow     = glGetUniformLocation(programObject, "uPalRow");
+#endif
+#ifdef S52_USE_TXT_SDF
+    _uSdfW       = glGetUniformLocation(programObject, "uSdfW");
+#endif
+#ifdef S52_USE_SY_INST
+    _uInstOn     = glGetUniformLocation(programObject, "uInstOn");
+    _uInstScale  = glGetUniformLocation(programObject, "uInstScale");
+#endif
+
     return programObject;
 }
 
@@ -1476,6 +2004,8 @@ static int       _init_gl2(void)
         _tessWorkBuf_d = g_array_new(FALSE, FALSE, sizeof(double)*3);
     if (NULL == _tessWorkBuf_f)
         _tessWorkBuf_f = g_array_new(FALSE, FALSE, sizeof(float)*3);
+    if (NULL == _lineWorkBuf_f)
+        _lineWorkBuf_f = g_array_new(FALSE, FALSE, sizeof(float)*4);
 
     _init_freetype_gl();
 
@@ -1760,8 +2290,10 @@ static int       _renderTexure(S52_obj *obj, double tileWpx, double tileHpx, dou
 
     _initFBO(mask_texID);
 
+#ifndef S52_USE_AP_CACHE
     // save texture mask ID when everythings check ok
     S52_PL_setAPtexID(obj, mask_texID);
+#endif
 
     // Clear Color ------------------------------------------------
     glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -1776,7 +2308,7 @@ static int       _renderTexure(S52_obj *obj, double tileWpx, double tileHpx, dou
 #endif
 
     // set color alpha
-    glUniform4f(_uColor, 0.0, 0.0, 0.0, 1.0);
+    _glColor4ub(0, 0, 0, '0');
 
     _checkError("_renderTexure() -1-");
 
@@ -1910,6 +2442,78 @@ static int       _renderTexure(S52_obj *obj, double tileWpx, double tileHpx, dou
     return mask_texID;
 }
 
+#ifdef S52_USE_AP_CACHE
+static void      _APtexDel(gpointer key, gpointer value, gpointer user_data)
+{
+    (void)key;
+    (void)user_data;
+
+    GLuint texID = GPOINTER_TO_UINT(value);
+#if !defined(S52_USE_GLSC2)
+    glDeleteTextures(1, &texID);
+#endif
+
+    return;
+}
+
+static int       _APtexCacheDone(void)
+{
+    if (NULL != _APtexCache) {
+        g_hash_table_foreach(_APtexCache, _APtexDel, NULL);
+        g_hash_table_destroy(_APtexCache);
+        _APtexCache = NULL;
+    }
+    if (NULL != _APtexKey) {
+        g_string_free(_APtexKey, TRUE);
+        _APtexKey = NULL;
+    }
+
+    return TRUE;
+}
+
+static GLuint    _APtexCacheGet(S52_obj *obj, double tileWpx, double tileHpx, double stagOffsetPix)
+// return tile texture of this pattern / size, render it on a miss
+// return 0 if obj has no pattern name (no pattern def) - not cached
+{
+    CCHAR *APname = S52_PL_getAPname(obj);
+    if (NULL == APname)
+        return 0;
+
+    double dotpitX = S52_MP_get(S52_MAR_DOTPITCH_MM_X);
+    double dotpitY = S52_MP_get(S52_MAR_DOTPITCH_MM_Y);
+    if ((dotpitX != _APtexDotpitX) || (dotpitY != _APtexDotpitY)) {
+        _APtexCacheDone();
+        _APtexDotpitX = dotpitX;
+        _APtexDotpitY = dotpitY;
+    }
+
+    if (NULL == _APtexCache) {
+        _APtexCache = g_hash_table_new_full(g_str_hash, g_str_equal, g_free, NULL);
+        _APtexKey   = g_string_new("");
+    }
+
+    g_string_printf(_APtexKey, "%s:%.2f:%.2f:%.2f", APname, tileWpx, tileHpx, stagOffsetPix);
+
+    GLuint mask_texID = GPOINTER_TO_UINT(g_hash_table_lookup(_APtexCache, _APtexKey->str));
+    if (0 != mask_texID)
+        return mask_texID;
+
+    if (TRUE == glIsEnabled(GL_SCISSOR_TEST)) {
+        // scissor box interfere with texture creation
+        glDisable(GL_SCISSOR_TEST);
+        mask_texID = _renderTexure(obj, tileWpx, tileHpx, stagOffsetPix);
+        glEnable(GL_SCISSOR_TEST);
+    } else {
+        mask_texID = _renderTexure(obj, tileWpx, tileHpx, stagOffsetPix);
+    }
+
+    if (0 != mask_texID)
+        g_hash_table_insert(_APtexCache, g_strdup(_APtexKey->str), GUINT_TO_POINTER(mask_texID));
+
+    return mask_texID;
+}
+#endif  // S52_USE_AP_CACHE
+
 static int       _renderAP_gl2(S52_obj *obj)
 {
     // debug
@@ -1936,6 +2540,11 @@ static int       _renderAP_gl2(S52_obj *obj)
 
     //PRINTF("DEBUG: %s: grid x1:%f y1:%f Ww:%f Hw:%f sop:%f\n", S52_PL_getOBCL(obj), LLx, LLy, tileWw, tileHw, stagOffsetPix);
 
+#ifdef S52_USE_AP_CACHE
+    GLuint mask_texID = _APtexCacheGet(obj, tileWpx, tileHpx, stagOffsetPix);
+    if (0 == mask_texID)
+        return FALSE;
+#else
     GLuint mask_texID = S52_PL_getAPtexID(obj);
     if (0 == mask_texID) {
         if (TRUE == glIsEnabled(GL_SCISSOR_TEST)) {
@@ -1947,6 +2556,7 @@ static int       _renderAP_gl2(S52_obj *obj)
             mask_texID = _renderTexure(obj, tileWpx, tileHpx, stagOffsetPix);
         }
     }
+#endif
 
     S52_DListData *DListData = S52_PL_getDListData(obj);
     _setFragAttrib(DListData->colors, S57_getHighlight(S52_PL_getGeo(obj)));
@@ -1980,33 +2590,20 @@ static int       _renderAP_gl2(S52_obj *obj)
     return TRUE;
 }
 
-static int       _renderLS_gl2(char style, guint npt, double *ppt)
+static int       _renderLS_begStip(char style)
+// bind the 1D dash/dott texture (32x1 pixels), the pattern run along the line arc length (aUV.x)
+// return FALSE if SOLD
 {
-    _d2f(_tessWorkBuf_f, npt, ppt);
-
     switch (style) {
 
         case 'L': // SOLD --correct
-            // but this stippling break up antialiase
-            //glLineStipple(1, 0xFFFF);
-            _glUniformMatrix4fv_uModelview();
-            _DrawArrays_LINE_STRIP(npt, (vertex_t *)_tessWorkBuf_f->data);
-
-            return TRUE;
+            return FALSE;
 
         case 'S': // DASH (dash 3.6mm, space 1.8mm) --incorrect  (last space 1.8mm instead of 1.2mm)
-            //glEnable(GL_LINE_STIPPLE);
-            //_glLineStipple(3, 0x7777);
-            //glLineStipple(2, 0x9248);  // !!
             glBindTexture(GL_TEXTURE_2D, _dashpa_mask_texID);
-            // debug
-            //return TRUE;
             break;
 
         case 'T': // DOTT (dott 0.6mm, space 1.2mm) --correct
-            //glEnable(GL_LINE_STIPPLE);
-            //_glLineStipple(1, 0xFFF0);
-            //_glPointSize(pen_w - '0');
             glBindTexture(GL_TEXTURE_2D, _dottpa_mask_texID);
             break;
 
@@ -2016,33 +2613,159 @@ static int       _renderLS_gl2(char style, guint npt, double *ppt)
             return FALSE;
     }
 
-    // FIXME: use GL_POINTS if DOTT
     glUniform1f(_uTextOn, 1.0);
+    glUniform1f(_uStipW,  32.0 * _scalex);  // pattern width in world
+
+    return TRUE;
+}
+
+static int       _renderLS_endStip(void)
+{
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glUniform1f(_uTextOn, 0.0);
+    glUniform1f(_uStipW,  0.0);
+
+    return TRUE;
+}
+
+static int       _renderLS_arrays(char style, guint npt, GLfloat *data)
+// one draw call for the whole line - data: NULL if VBO is bound (then ptr is an offset)
+{
+    const GLfloat *ptr = data;
+
     _glUniformMatrix4fv_uModelview();
 
-    float *v = (float *)_tessWorkBuf_f->data;
-    for (guint i=1; i<npt; ++i, ppt+=3, v+=3) {
-        float dx       = ppt[0] - ppt[3];
-        float dy       = ppt[1] - ppt[4];
-        float leglen_m = sqrt(dx*dx + dy*dy);   // leg length in meter
-        float leglen_px= leglen_m  / _scalex;   // leg length in pixel
-        float tex_n    = leglen_px / 32.0;      // number of texture pattern - 1D 32x1 pixels
-
-        float ptr[4] = {
-            0.0,   0.0,
-            tex_n, 1.0
-        };
+    glEnableVertexAttribArray(_aPosition);
+    glVertexAttribPointer    (_aPosition, 3, GL_FLOAT, GL_FALSE, 4*sizeof(GLfloat), ptr);
 
+    if (TRUE == _renderLS_begStip(style)) {
         glEnableVertexAttribArray(_aUV);
-        glVertexAttribPointer    (_aUV, 2, GL_FLOAT, GL_FALSE, 0, ptr);
+        glVertexAttribPointer    (_aUV,       1, GL_FLOAT, GL_FALSE, 4*sizeof(GLfloat), ptr+3);
 
-        //_DrawArrays_LINE_STRIP(npt, (vertex_t *)_tessWorkBuf_f->data);
-        _DrawArrays_LINE_STRIP(2, v);
+        glDrawArrays(GL_LINE_STRIP, 0, npt);
+
+        glDisableVertexAttribArray(_aUV);
+        _renderLS_endStip();
+    } else {
+        glDrawArrays(GL_LINE_STRIP, 0, npt);
     }
 
-    glDisableVertexAttribArray(_aUV);
-    glBindTexture(GL_TEXTURE_2D,  0);
-    glUniform1f(_uTextOn, 0.0);
+    glDisableVertexAttribArray(_aPosition);
+
+    return TRUE;
+}
+
+static int       _renderLS_gl2(char style, guint npt, double *ppt)
+// transient line (LC(), mariner object, ..) - from client memory
+{
+    // ie 'pastrk' after its first S52_pushPosition() - nothing to draw yet
+    if (npt < 2)
+        return TRUE;
+
+    _d2fArc(_lineWorkBuf_f, npt, ppt);
+
+    return _renderLS_arrays(style, npt, (GLfloat *)_lineWorkBuf_f->data);
+}
+
+#ifdef S52_USE_OPENGL_VBO
+static int       _renderLS_gl2VBO(S57_geo *geo, char style, guint npt, double *ppt)
+// static line (ENC) - XYZ + arc length uploaded once, then one draw call per LS()
+{
+    if ((npt < 2) || (TRUE == S57_getGeoDyn(geo)))
+        return _renderLS_gl2(style, npt, ppt);
+
+    gboolean stale = FALSE;
+    guint    vboID = S57_getLineVBO(geo, &stale);
+
+    if ((0 != vboID) && (TRUE == stale)) {
+#ifdef S52_USE_GLSC2
+        // SC can't delete a buffer
+        return _renderLS_gl2(style, npt, ppt);
+#else
+        glDeleteBuffers(1, &vboID);
+        vboID = 0;
+        S57_setLineVBO(geo, 0);
+#endif
+    }
+
+#ifdef S52_USE_LINE_LOD
+    // ENC line: every LOD level back to back in the VBO (level 0 only if no LOD, ie < 3 vertex)
+    guint nLOD = S57_getGeoLODnbr(geo);
+#endif
+
+    if (0 == vboID) {
+#ifndef S52_USE_LINE_LOD
+        _d2fArc(_lineWorkBuf_f, npt, ppt);
+#endif
+
+        glGenBuffers(1, &vboID);
+        if (0 == vboID) {
+            PRINTF("ERROR: glGenBuffers() fail\n");
+            g_assert(0);
+            return _renderLS_gl2(style, npt, ppt);
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, vboID);
+#ifdef S52_USE_LINE_LOD
+        {
+            guint   nTot = npt;
+            guint   n    = 0;
+            double *p    = NULL;
+            for (guint i=1; i<nLOD; ++i) {
+                S57_getGeoLOD(geo, i, &n, &p);
+                nTot += n;
+            }
+            glBufferData(GL_ARRAY_BUFFER, nTot*sizeof(GLfloat)*4, NULL, GL_STATIC_DRAW);
+
+            // arc length restart at each level - stipple stay continuous along a level
+            GLintptr offset = 0;
+            for (guint i=0; i<nLOD; ++i) {
+                if (0 == i) {
+                    n = npt;
+                    p = ppt;
+                } else {
+                    S57_getGeoLOD(geo, i, &n, &p);
+                }
+                _d2fArc(_lineWorkBuf_f, n, p);
+                glBufferSubData(GL_ARRAY_BUFFER, offset, n*sizeof(GLfloat)*4, (const void *)_lineWorkBuf_f->data);
+                offset += n*sizeof(GLfloat)*4;
+            }
+        }
+#else
+        glBufferData(GL_ARRAY_BUFFER, npt*sizeof(GLfloat)*4, (const void *)_lineWorkBuf_f->data, GL_STATIC_DRAW);
+#endif
+
+        S57_setLineVBO(geo, vboID);
+
+        _checkError("_renderLS_gl2VBO() -new VBO-");
+    } else {
+        glBindBuffer(GL_ARRAY_BUFFER, vboID);
+    }
+
+#ifdef S52_USE_LINE_LOD
+    if (1 < nLOD) {
+        // level tolerance is under a pixel at this scale
+        guint   level = S57_getLODlevel(_scalex);
+        guint   first = npt;
+        guint   n     = npt;
+        double *p     = NULL;
+        for (guint i=1; i<=level; ++i) {
+            S57_getGeoLOD(geo, i, &n, &p);
+            if (i < level)
+                first += n;
+        }
+        if (0 == level)
+            first = 0;
+
+        _renderLS_arrays(style, n, (GLfloat *)((char *)NULL + first*sizeof(GLfloat)*4));
+    } else
+#endif
+    {
+        _renderLS_arrays(style, npt, NULL);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
 
     return TRUE;
 }
+#endif  // S52_USE_OPENGL_VBO
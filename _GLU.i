@@ -32,14 +32,17 @@ static GLUtriangulatorObj *_tcen       = NULL;     // GLU CSG - Computational So
 static GArray             *_vertexs    = NULL;
 static GArray             *_nvertex    = NULL;     // list of nbr of vertex per poly in _vertexs
 static GArray             *_centroids  = NULL;     // centroids of poly's in _vertexs
+static GPtrArray          *_tmpVcen    = NULL;     // combine place holder for _tcen / _tcin (not shared with _tobj)
 
 // check if centroid is inside the poly
 static GLUtriangulatorObj *_tcin       = NULL;
 static GLboolean           _startEdge  = GL_TRUE;  // start inside edge --for heuristic of centroid in poly
+static GLboolean           _startEdgeCin = GL_TRUE; // same for _tcin (_startEdge is also set by _tobj)
 static int                 _inSeg      = FALSE;    // next vertex will complete an edge
 
 // HO Data Limit
 static GLUtriangulatorObj *_tUnion     = NULL;
+static GArray             *_vertexsU   = NULL;     // union output (not shared with centroid)
 
 // experimental: centroid inside poly heuristic
 static double _dcin;
@@ -275,6 +278,25 @@ static void_cb_t _edgeFlag(GLboolean flag)
     //PRINTF("%i\n", flag);
 }
 
+static void_cb_t _edgeFlagCin(GLboolean flag)
+{
+    _startEdgeCin = (GL_FALSE == flag)? GL_TRUE : GL_FALSE;
+}
+
+static GLdouble  *_combineNew(GLdouble coords[3], GPtrArray *tmpV)
+// new vertex, freed by _g_ptr_array_clear(tmpV)
+{
+    // optimisation: alloc once --keep pos. of current index
+    pt3 *p = g_new(pt3, 1);
+    p->x   = coords[0];
+    p->y   = coords[1];
+    p->z   = coords[2];
+
+    g_ptr_array_add(tmpV, (gpointer) p);
+
+    return (GLdouble*)p;
+}
+
 static void_cb_t _combineCallback(GLdouble   coords[3],
                                   GLdouble  *vertex_data[4],
                                   GLfloat    weight[4],
@@ -288,17 +310,19 @@ static void_cb_t _combineCallback(GLdouble   coords[3],
     // weight      not used
     (void) weight;
 
-    // optimisation: alloc once --keep pos. of current index
-    pt3 *p = g_new(pt3, 1);
-    p->x   = coords[0];
-    p->y   = coords[1];
-    p->z   = coords[2];
-    *dataOut = (GLdouble*)p;
+    *dataOut = _combineNew(coords, _tmpV);
+}
 
-    // debug
-    g_ptr_array_add(_tmpV, (gpointer) p);
-    //g_ptr_array_add(tmpV, (GLdouble*) p);
+static void_cb_t _combineCen(GLdouble   coords[3],
+                             GLdouble  *vertex_data[4],
+                             GLfloat    weight[4],
+                             GLdouble **dataOut )
+// _tcen / _tcin - centroid can be computed outside the main thread
+{
+    (void) vertex_data;
+    (void) weight;
 
+    *dataOut = _combineNew(coords, _tmpVcen);
 }
 
 static void_cb_t _glBeg(GLenum mode, S57_prim *prim)
@@ -382,7 +406,7 @@ static void_cb_t _vertexUnion(GLvoid *data)
         // debug
         //PRINTF("%f %f\n", p->x, p->y);
 
-        g_array_append_val(_vertexs, *p);
+        g_array_append_val(_vertexsU, *p);
     //}
 }
 
@@ -398,7 +422,7 @@ static void_cb_t _vertexCin(GLvoid *data)
     } else
         pt[0] = *p;
 
-    _inSeg = (_startEdge)? TRUE : FALSE;
+    _inSeg = (_startEdgeCin)? TRUE : FALSE;
 }
 
 static GLint     _initGLU(void)
@@ -472,6 +496,7 @@ static GLint     _initGLU(void)
         _centroids = g_array_new(FALSE, FALSE, sizeof(double)*3);
         _vertexs   = g_array_new(FALSE, FALSE, sizeof(double)*3);
         _nvertex   = g_array_new(FALSE, FALSE, sizeof(int));
+        _tmpVcen   = g_ptr_array_new();
 
         //gluTessProperty(_tcen, GLU_TESS_WINDING_RULE, GLU_TESS_WINDING_POSITIVE);
         //gluTessProperty(_tcen, GLU_TESS_WINDING_RULE, GLU_TESS_WINDING_NEGATIVE);
@@ -486,7 +511,7 @@ static GLint     _initGLU(void)
         gluTessCallback(_tcen, GLU_TESS_END,    (f)_endCen);
         gluTessCallback(_tcen, GLU_TESS_VERTEX, (f)_vertexCen);
         gluTessCallback(_tcen, GLU_TESS_ERROR,  (f)_tessError);
-        gluTessCallback(_tcen, GLU_TESS_COMBINE,(f)_combineCallback);
+        gluTessCallback(_tcen, GLU_TESS_COMBINE,(f)_combineCen);
 
         // set poly in x-y plane normal is Z (for performance)
         gluTessNormal(_tcen, 0.0, 0.0, 1.0);
@@ -511,8 +536,8 @@ static GLint     _initGLU(void)
         gluTessCallback(_tcin, GLU_TESS_END,       (f)_endCin);
         gluTessCallback(_tcin, GLU_TESS_VERTEX,    (f)_vertexCin);
         gluTessCallback(_tcin, GLU_TESS_ERROR,     (f)_tessError);
-        gluTessCallback(_tcin, GLU_TESS_COMBINE,   (f)_combineCallback);
-        gluTessCallback(_tcin, GLU_TESS_EDGE_FLAG, (f)_edgeFlag);
+        gluTessCallback(_tcin, GLU_TESS_COMBINE,   (f)_combineCen);
+        gluTessCallback(_tcin, GLU_TESS_EDGE_FLAG, (f)_edgeFlagCin);
 
         // set poly in x-y plane normal is Z (for performance)
         gluTessNormal(_tcin, 0.0, 0.0, 1.0);
@@ -530,10 +555,12 @@ static GLint     _initGLU(void)
 
         gluTessProperty(_tUnion, GLU_TESS_BOUNDARY_ONLY, GLU_TRUE);
 
-        // use _vertexs to hold Union
+        // use _vertexsU to hold Union
+        _vertexsU = g_array_new(FALSE, FALSE, sizeof(double)*3);
+
         gluTessCallback(_tUnion, GLU_TESS_BEGIN,     (f)_begCin);       // do nothing
         gluTessCallback(_tUnion, GLU_TESS_END,       (f)_endCin);       // do nothing
-        gluTessCallback(_tUnion, GLU_TESS_VERTEX,    (f)_vertexUnion);  // fill _vertexs
+        gluTessCallback(_tUnion, GLU_TESS_VERTEX,    (f)_vertexUnion);  // fill _vertexsU
         gluTessCallback(_tUnion, GLU_TESS_ERROR,     (f)_tessError);
         gluTessCallback(_tUnion, GLU_TESS_COMBINE,   (f)_combineCallback);
 
@@ -595,6 +622,10 @@ static GLint     _freeGLU(void)
     _vertexs = NULL;
     if (NULL != _nvertex)   g_array_free(_nvertex,   TRUE);
     _nvertex = NULL;
+    if (NULL != _tmpVcen)   g_ptr_array_free(_tmpVcen, TRUE);
+    _tmpVcen = NULL;
+    if (NULL != _vertexsU)  g_array_free(_vertexsU,  TRUE);
+    _vertexsU = NULL;
 
     return TRUE;
 }
@@ -645,7 +676,7 @@ static S57_prim *_tessd(GLUtriangulatorObj *tobj, S57_geo *geo)
 void      S52_GLU_begUnion(void)
 {
     _g_ptr_array_clear(_tmpV);
-    g_array_set_size(_vertexs, 0);
+    g_array_set_size(_vertexsU, 0);
 
     gluTessBeginPolygon(_tUnion, NULL);
 
@@ -676,8 +707,8 @@ void      S52_GLU_endUnion(guint *npt, double **ppt)
 {
     gluTessEndPolygon(_tUnion);
 
-    *npt =          _vertexs->len;
-    *ppt = (double*)_vertexs->data;
+    *npt =          _vertexsU->len;
+    *ppt = (double*)_vertexsU->data;
 
     return;
 }
@@ -20,6 +20,7 @@
 #include <gio/gio.h>
 #include "parson.h"
 
+// Note: one read per message - a JSON message (ie all params) must fit in SOCK_BUF-1 byte
 #define SOCK_BUF 2048
 
 static gchar               _setErr(char *err, gchar *errmsg)
@@ -247,6 +248,43 @@ static int                 _handleS52method(const gchar *str, char *result, char
         goto exit;
     }
 
+    //int STD S52_setVESSELbatch(unsigned int n, S52ObjectHandle *objH, double *latitude, double *longitude,
+    //                           double *course, double *speed, double *heading, int *vestat);
+    // params: flat array of 7 x n: [objH,latitude,longitude,course,speed,heading,vestat, ..]
+    // Note: the message is capped by SOCK_BUF - about 25 target (70 char each) per call,
+    // a client split a bigger batch in many call (see test/s52ais.c)
+    if (0 == g_strcmp0(cmdName, "S52_setVESSELbatch")) {
+        if ((0==count) || (0!=(count%7))) {
+            _setErr(err, "params 'objH'/'latitude'/'longitude'/'course'/'speed'/'heading'/'vestat' (x n) not found");
+            goto exit;
+        }
+
+        guint            n       = count / 7;
+        S52ObjectHandle *objH    = g_new(S52ObjectHandle, n);
+        double          *val     = g_new(double, n*5);  // latitude, longitude, course, speed, heading
+        int             *vestat  = g_new(int, n);
+        for (guint i=0; i<n; ++i) {
+            long unsigned int lui = (long unsigned int) json_array_get_number(paramsArr, i*7 + 0);
+            objH[i]    = (S52ObjectHandle) lui;
+            val[i+0*n] = json_array_get_number(paramsArr, i*7 + 1);  // latitude
+            val[i+1*n] = json_array_get_number(paramsArr, i*7 + 2);  // longitude
+            val[i+2*n] = json_array_get_number(paramsArr, i*7 + 3);  // course
+            val[i+3*n] = json_array_get_number(paramsArr, i*7 + 4);  // speed
+            val[i+4*n] = json_array_get_number(paramsArr, i*7 + 5);  // heading
+            vestat[i]  = (int) json_array_get_number(paramsArr, i*7 + 6);
+        }
+
+        int nUpd = S52_setVESSELbatch(n, objH, val+0*n, val+1*n, val+2*n, val+3*n, val+4*n, vestat);
+
+        g_free(vestat);
+        g_free(val);
+        g_free(objH);
+
+        _encode(result, "[%i]", nUpd);
+
+        goto exit;
+    }
+
     //S52ObjectHandle STD S52_delMarObj(S52ObjectHandle objH);
     if (0 == g_strcmp0(cmdName, "S52_delMarObj")) {
         if (1 != count) {
@@ -313,6 +351,30 @@ static int                 _handleS52method(const gchar *str, char *result, char
         goto exit;
     }
 
+    //const char * STD S52_getFrameStats(unsigned int nFrame);
+    if (0 == g_strcmp0(cmdName, "S52_getFrameStats")) {
+        if (1 != count) {
+            _setErr(err, "params 'nFrame' not found");
+            goto exit;
+        }
+
+        double nFrame = json_array_get_number(paramsArr, 0);
+
+        const char *statsstr = S52_getFrameStats((unsigned int)nFrame);
+        if (NULL == statsstr) {
+            _setErr(err, "S52_getFrameStats() failed");
+            goto exit;
+        }
+
+        // Note: SOCK_BUF hold about 3 frames
+        if (FALSE == _encode(result, "[%s]", statsstr)) {
+            result[0] = '\0';
+            _setErr(err, "S52_getFrameStats(): reply too big for SOCK_BUF - lower 'nFrame'");
+        }
+
+        goto exit;
+    }
+
     //double STD S52_getMarinerParam(S52MarinerParameter paramID);
     if (0 == g_strcmp0(cmdName, "S52_getMarinerParam")) {
         if (1 != count) {
@@ -877,7 +939,8 @@ static gboolean            _socket_read_write(GIOChannel *source, GIOCondition c
             gchar   str_read[SOCK_BUF] = {'\0'};
             gsize   length             = 0;
             GError *error              = NULL;
-            GIOStatus stat = g_io_channel_read_chars(source, str_read, SOCK_BUF, &length, &error);
+            // SOCK_BUF-1: keep str_read '\0' terminated
+            GIOStatus stat = g_io_channel_read_chars(source, str_read, SOCK_BUF-1, &length, &error);
 
             // can't read line on raw socket
             //gsize   terminator_pos = 0;
@@ -901,6 +964,10 @@ static gboolean            _socket_read_write(GIOChannel *source, GIOCondition c
                 PRINTF("DEBUG: length=%i\n", length);
                 return FALSE;
             }
+            if ((SOCK_BUF-1) == length) {
+                // the JSON parser will fail on the truncated message and reply an error
+                PRINTF("WARNING: socket message over SOCK_BUF (%i) - truncated\n", SOCK_BUF);
+            }
 
             // Not a WebSocket connection - normal JSON handling
             if ('{' == str_read[0]) {
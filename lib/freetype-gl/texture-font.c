@@ -237,6 +237,104 @@ texture_font_generate_kerning( texture_font_t *self )
 }
 
 
+// ------------------------------------------------------ make_distance_map ---
+// 8-point signed sequential euclidean distance transform (two passes)
+// of a coverage bitmap, output padded by 'spread' on each side:
+// 128 on the edge, >128 inside, 0/255 at 'spread' pixel out/in
+typedef struct { int dx, dy; } sdf_point;
+
+static void
+sdf_compare( sdf_point *g, int w, int x, int y, int ox, int oy )
+{
+    sdf_point p = g[(y+oy)*w + x+ox];
+    p.dx += ox;
+    p.dy += oy;
+    sdf_point *c = &g[y*w + x];
+    if( p.dx*p.dx + p.dy*p.dy < c->dx*c->dx + c->dy*c->dy )
+        *c = p;
+}
+
+static void
+sdf_sweep( sdf_point *g, int w, int h )
+{
+    int x, y;
+    for( y=1; y<h-1; ++y )
+    {
+        for( x=1; x<w-1; ++x )
+        {
+            sdf_compare( g, w, x, y, -1,  0 );
+            sdf_compare( g, w, x, y,  0, -1 );
+            sdf_compare( g, w, x, y, -1, -1 );
+            sdf_compare( g, w, x, y,  1, -1 );
+        }
+        for( x=w-2; x>0; --x )
+            sdf_compare( g, w, x, y,  1,  0 );
+    }
+    for( y=h-2; y>0; --y )
+    {
+        for( x=w-2; x>0; --x )
+        {
+            sdf_compare( g, w, x, y,  1,  0 );
+            sdf_compare( g, w, x, y,  0,  1 );
+            sdf_compare( g, w, x, y, -1,  1 );
+            sdf_compare( g, w, x, y,  1,  1 );
+        }
+        for( x=1; x<w-1; ++x )
+            sdf_compare( g, w, x, y, -1,  0 );
+    }
+}
+
+static unsigned char *
+make_distance_map( const unsigned char *img, int pitch,
+                   int width, int height, int spread )
+{
+    // +1 border so the sweep need no bound check
+    int w = width  + 2*spread + 2;
+    int h = height + 2*spread + 2;
+    sdf_point far  = { 9999, 9999 };
+    sdf_point zero = { 0, 0 };
+    sdf_point *in  = (sdf_point *) g_malloc( w*h*sizeof(sdf_point) );
+    sdf_point *out = (sdf_point *) g_malloc( w*h*sizeof(sdf_point) );
+    unsigned char *map = (unsigned char *) g_malloc( (w-2)*(h-2) );
+    int x, y;
+
+    for( y=0; y<h; ++y )
+    {
+        for( x=0; x<w; ++x )
+        {
+            int gx = x - spread - 1;
+            int gy = y - spread - 1;
+            int inside = (gx>=0 && gy>=0 && gx<width && gy<height &&
+                          img[gy*pitch + gx] > 127);
+            in [y*w + x] = inside ? far  : zero;
+            out[y*w + x] = inside ? zero : far;
+        }
+    }
+    // in: distance to nearest outside pixel, out: to nearest inside pixel
+    sdf_sweep( in,  w, h );
+    sdf_sweep( out, w, h );
+
+    for( y=1; y<h-1; ++y )
+    {
+        for( x=1; x<w-1; ++x )
+        {
+            sdf_point *a = &in [y*w + x];
+            sdf_point *b = &out[y*w + x];
+            float d = sqrtf( (float)(a->dx*a->dx + a->dy*a->dy) )
+                    - sqrtf( (float)(b->dx*b->dx + b->dy*b->dy) );
+            float v = 128.0f + 127.0f * d / spread;
+            map[(y-1)*(w-2) + x-1] = (unsigned char)
+                (v < 0.0f ? 0.0f : (v > 255.0f ? 255.0f : v));
+        }
+    }
+
+    g_free( in );
+    g_free( out );
+
+    return map;
+}
+
+
 // ------------------------------------------------------- texture_font_new ---
 texture_font_t *
 texture_font_new( texture_atlas_t * atlas,
@@ -265,6 +363,7 @@ texture_font_new( texture_atlas_t * atlas,
     self->size      = size;
     self->outline_type = 0;
     self->outline_thickness = 0.0;
+    self->sdf_spread = 0;
     self->hinting   = 1;
     self->filtering = 1;
     // FT_LCD_FILTER_LIGHT   is (0x00, 0x55, 0x56, 0x55, 0x00)
@@ -505,6 +604,19 @@ texture_font_load_glyphs( texture_font_t * self,
         }
 
 
+        // distance field - padded by the spread
+        unsigned char *sdf = NULL;
+        if( self->sdf_spread > 0 && depth == 1 )
+        {
+            int pad = self->sdf_spread;
+            sdf = make_distance_map( ft_bitmap.buffer, ft_bitmap.pitch,
+                                     ft_bitmap_width, ft_bitmap_rows, pad );
+            ft_bitmap_width += 2*pad;
+            ft_bitmap_rows  += 2*pad;
+            ft_glyph_left   -= pad;
+            ft_glyph_top    += pad;
+        }
+
         // We want each glyph to be separated by at least one black pixel
         // (for example for shader used in demo-subpixel.c)
         w = ft_bitmap_width/depth + 1;
@@ -514,14 +626,23 @@ texture_font_load_glyphs( texture_font_t * self,
         {
             missed++;
             fprintf( stderr, "Texture atlas is full (line %d)\n",  __LINE__ );
+            g_free( sdf );
             continue;
         }
         w = w - 1;
         h = h - 1;
         x = region.XYZW.x;
         y = region.XYZW.y;
-        texture_atlas_set_region( self->atlas, x, y, w, h,
-                                  ft_bitmap.buffer, ft_bitmap.pitch );
+        if( NULL != sdf )
+        {
+            texture_atlas_set_region( self->atlas, x, y, w, h, sdf, w );
+            g_free( sdf );
+        }
+        else
+        {
+            texture_atlas_set_region( self->atlas, x, y, w, h,
+                                      ft_bitmap.buffer, ft_bitmap.pitch );
+        }
 
         glyph = texture_glyph_new( );
         glyph->charcode = charcodes[i];
@@ -229,6 +229,13 @@ typedef struct
      */
     float outline_thickness;
 
+    /**
+     * Signed distance field spread in pixel (0 = coverage bitmap).
+     * When set, glyphs are stored as a distance field (0.5 on the edge)
+     * padded by this spread, so one size can be scaled / rotated (depth 1 only).
+     */
+    int sdf_spread;
+
     /** 
      * Whether to use our own lcd filter.
      */
@@ -180,6 +180,13 @@ typedef struct _ais_t {
     double          course;   // _setAISVec()
     double          speed;    // _setAISVec()
 
+    // position report waiting for _flushAISbatch()
+    int             batch;    // TRUE if queued
+    double          lat;
+    double          lon;
+    double          heading;
+    int             vestat;
+
     // -------------------------
     GTimeVal        lastUpdate;
     // optimisation: don't call update() when target lost after X sec, show iso date
@@ -207,6 +214,24 @@ static GMutex        _ais_list_mutex; // protect _ais_list
 
 #define AIS_SILENCE_MAX 600         // (10 min) sec of silence from an AIS before lost
 
+// S52_setVESSELbatch(): max target per call
+// Note: SOCK - a message must fit in libS52 socket buffer (SOCK_BUF 2048 in _S52.i),
+// at most 70 char per target
+#ifdef S52_USE_SOCK
+#define AIS_BATCH_MAX     24
+#else
+#define AIS_BATCH_MAX   1024
+#endif
+#define AIS_BATCH_USEC  (500 * 1000)  // 0.5 sec - max delay of a queued report
+
+static guint  _nBatch    = 0;         // target queued
+static gint64 _batchTime = 0;         // last _flushAISbatch()
+#ifndef S52_USE_SOCK
+static S52ObjectHandle _batchH  [AIS_BATCH_MAX];
+static double          _batchVal[AIS_BATCH_MAX * 5];  // lat, lon, course, speed, heading
+static int             _batchSta[AIS_BATCH_MAX];
+#endif
+
 //#define MAX_AFGLOW_PT (15 * 60)   // 15 min trail @ 1 pos per sec - trail too long
 #define MAX_AFGLOW_PT (12 * 20)     // 12 min @ 1 pos per 5 sec
 //#define MAX_AFGLOW_PT 10          // debug
@@ -1007,12 +1032,141 @@ static int           _setAISSta (unsigned int mmsi, int status, int turn)
     return TRUE;
 }
 
+static int           _setAISBatch(unsigned int mmsi, double lat, double lon, double course, double speed,
+                                  double heading, int status, int turn)
+// queue a position report (types 1,2,3,18) - sent by _flushAISbatch() in one S52_setVESSELbatch()
+{
+    // debug: ownshp is not a 'vessel' - skipped by S52_setVESSELbatch()
+    if (OWNSHIP == mmsi) {
+        _setAISPos(mmsi, lat, lon, heading);
+        _setAISVec(mmsi, course, speed);
+        return _setAISSta(mmsi, status, turn);
+    }
+
+    _ais_t *ais = _getAIS(mmsi);
+    if (NULL == ais)
+        return FALSE;
+
+    // new target - set vecstb (not in batch)
+    if (-1.0 == ais->course)
+        _setAISVec(mmsi, course, speed);
+
+    // turn is not in batch - send state only on change
+    _setAISSta(mmsi, status, turn);
+
+    ais->lat     = lat;
+    ais->lon     = lon;
+    ais->course  = course;
+    ais->speed   = speed;
+    ais->heading = heading;
+    ais->vestat  = (1==ais->status || 5==ais->status || 6==ais->status) ? 2 : 3;  // see _setAISSta()
+    if (FALSE == ais->batch) {
+        ais->batch = TRUE;
+        ++_nBatch;
+    }
+
+    // afterglow is not a 'vessel' - not in batch
+#ifdef S52_USE_AFGLOW
+#ifdef S52_USE_SOCK
+    _encodeNsend("S52_pushPosition", "%lu,%lf,%lf,%lf", (long unsigned int *)ais->afglowH, lat, lon, heading);
+#else
+    S52_pushPosition(ais->afglowH, lat, lon, 0.0);
+#endif
+#endif
+
+#ifdef S52_USE_DBUS
+    _signal_setPosition   (_dbus, ais->vesselH, lat, lon, heading);
+    _signal_setVESSELlabel(_dbus, ais->vesselH, ais->name);
+    _signal_setVector     (_dbus, ais->vesselH,  1, course, speed);
+#endif
+
+    g_get_current_time(&ais->lastUpdate);
+
+    return TRUE;
+}
+
+static int           _sendAISbatch(guint n)
+{
+    if (0 == n)
+        return TRUE;
+
+#ifdef S52_USE_SOCK
+    // params already in _params
+    if (NULL == _s52_send_cmd("S52_setVESSELbatch", _params))
+        return FALSE;
+#else
+    S52_setVESSELbatch(n, _batchH, _batchVal+0*AIS_BATCH_MAX, _batchVal+1*AIS_BATCH_MAX,
+                       _batchVal+2*AIS_BATCH_MAX, _batchVal+3*AIS_BATCH_MAX, _batchVal+4*AIS_BATCH_MAX, _batchSta);
+#endif
+
+    return TRUE;
+}
+
+static int           _flushAISbatch(int force)
+// send queued report, AIS_BATCH_MAX target per S52_setVESSELbatch()
+// force FALSE: only if the batch is full or the oldest report is AIS_BATCH_USEC old
+{
+    if (NULL == _ais_list)
+        return FALSE;
+
+    gint64 now = g_get_monotonic_time();
+    if ((FALSE==force) && (_nBatch<AIS_BATCH_MAX) && (now-_batchTime<AIS_BATCH_USEC))
+        return TRUE;
+
+    _batchTime = now;
+    if (0 == _nBatch)
+        return TRUE;
+
+    guint n   = 0;
+#ifdef S52_USE_SOCK
+    guint len = 0;
+#endif
+    for (guint i=0; i<_ais_list->len; ++i) {
+        _ais_t *ais = &g_array_index(_ais_list, _ais_t, i);
+        if (FALSE == ais->batch)
+            continue;
+        ais->batch = FALSE;
+
+#ifdef S52_USE_SOCK
+        len += g_snprintf(_params+len, BUFSZ-len, "%s%u,%.6f,%.6f,%.1f,%.1f,%.1f,%i", (0==n) ? "" : ",",
+                          ais->vesselH, ais->lat, ais->lon, ais->course, ais->speed, ais->heading, ais->vestat);
+#else
+        _batchH  [n]                   = ais->vesselH;
+        _batchVal[n + 0*AIS_BATCH_MAX] = ais->lat;
+        _batchVal[n + 1*AIS_BATCH_MAX] = ais->lon;
+        _batchVal[n + 2*AIS_BATCH_MAX] = ais->course;
+        _batchVal[n + 3*AIS_BATCH_MAX] = ais->speed;
+        _batchVal[n + 4*AIS_BATCH_MAX] = ais->heading;
+        _batchSta[n]                   = ais->vestat;
+#endif
+
+        if (AIS_BATCH_MAX == ++n) {
+            _sendAISbatch(n);
+            n   = 0;
+#ifdef S52_USE_SOCK
+            len = 0;
+#endif
+        }
+    }
+    _sendAISbatch(n);
+
+    _nBatch = 0;
+
+    return TRUE;
+}
+
 static int           _setAISDel (_ais_t *ais)
 {
     if (NULL == ais) {
         g_print("s52ais:_setAISDel(): WARNING: AIS is NULL!\n");
     }
 
+    // not in the next batch
+    if (TRUE == ais->batch) {
+        ais->batch = FALSE;
+        --_nBatch;
+    }
+
 #ifdef S52_USE_DBUS
     _signal_delMarObj(_dbus, ais->vesselH, ais->name);
 #endif
@@ -1243,9 +1397,7 @@ static void          _updateAISdata(struct gps_data_t *gpsdata)
         //  127     - turning right at more than 5deg/30s (No TI available)
         // -127     - turning left at more than 5deg/30s (No TI available)
         //  128     - (80 hex) indicates no turn information available (default)
-        _setAISPos(gpsdata->ais.mmsi, lat, lon, heading);
-        _setAISVec(gpsdata->ais.mmsi, course, speed);
-        _setAISSta(gpsdata->ais.mmsi, status, turn);
+        _setAISBatch(gpsdata->ais.mmsi, lat, lon, course, speed, heading, status, turn);
 
         return;
     }
@@ -1413,13 +1565,10 @@ unsigned int radio;		    // radio status bits
             // speed not available
             if (102.3 == speed)   speed = 0.0;
 
-            _setAISPos(gpsdata->ais.mmsi, lat, lon, heading);
-            _setAISVec(gpsdata->ais.mmsi, course, speed);
-
             int turn   = 0;  // not turning
             // debug close quarter, red
             int status = 0;  // under way
-            _setAISSta(gpsdata->ais.mmsi, status, turn);
+            _setAISBatch(gpsdata->ais.mmsi, lat, lon, course, speed, heading, status, turn);
         }
 
         return;
@@ -1531,6 +1680,7 @@ static int           _gpsdClientReadLoop(void)
                 // handle AIS data
                 GMUTEXLOCK(&_ais_list_mutex);
                 _updateAISdata(&_gpsdata);
+                _flushAISbatch(FALSE);
                 GMUTEXUNLOCK(&_ais_list_mutex);
 
                 continue;
@@ -1545,6 +1695,11 @@ static int           _gpsdClientReadLoop(void)
 
                 goto exit;
             }
+        } else {
+            // timed out - no more data, send what is queued
+            GMUTEXLOCK(&_ais_list_mutex);
+            _flushAISbatch(TRUE);
+            GMUTEXUNLOCK(&_ais_list_mutex);
         }
     }
 
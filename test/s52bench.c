@@ -0,0 +1,552 @@
+// s52bench.c: headless S52 benchmark driver - EGL pbuffer, no window, no main loop.
+//
+// headless counterpart of s52egl.c, used to time libS52 and dump reference frames
+
+/*
+    This file is part of the OpENCview project, a viewer of ENC.
+    Copyright (C) 2000-2017 Sylvain Duclos sduclos@users.sourceforge.net
+
+    OpENCview is free software: you can redistribute it and/or modify
+    it under the terms of the Lesser GNU General Public License as published by
+    the Free Software Foundation, either version 3 of the License, or
+    (at your option) any later version.
+
+    OpENCview is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    Lesser GNU General Public License for more details.
+
+    You should have received a copy of the Lesser GNU General Public License
+    along with OpENCview.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+// Usage:
+//   $ s52bench [-W width] [-H height] [-s script] [-n repeat] [-o out.json] [-d dumpDir] [cell.000 ..]
+//
+// If no cell is given the 'CHART' label of s52.cfg is used (ie S52_loadCell(NULL, NULL)).
+//
+// Script: one command per line, '#' start a comment
+//   view <lat> <lon> <rangeNM> <north>   - S52_setView()
+//   mar  <S52MarinerParameter> <val>     - S52_setMarinerParam() (enum value, see S52.h)
+//   pick <x> <y>                         - S52_pickAt()
+//   draw                                 - S52_draw()     (timed frame)
+//   last                                 - S52_drawLast() (timed frame)
+//   dump <name>                          - dump framebuffer to <dumpDir>/<name>.png (need -d)
+//
+// Without a script: one draw() and 10 drawLast() on the initial view of the cells.
+//
+// The report (JSON) goes to stdout (or -o file): load time, per-frame time
+// percentiles of draw() and drawLast(), pick time, peak RSS, and the per-stage
+// breakdown of S52_getFrameStats() if libS52 is compiled with S52_USE_FRAME_STATS.
+// A draw/last that return FALSE is not timed; failed frames and commands are
+// counted in the report ("failFrame", "failCmd") and s52bench then exit with 1.
+//
+// Headless on Mesa: $ EGL_PLATFORM=surfaceless LIBGL_ALWAYS_SOFTWARE=1 ./s52bench ..
+// (llvmpipe), then compare PNG with test/ref_dump (see test/ref_dump/README).
+
+
+#include "S52.h"
+
+#define EGL_EGLEXT_PROTOTYPES 1
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include <stdio.h>        // printf(), fopen()
+#include <stdlib.h>       // qsort()
+#include <string.h>       // strcmp()
+#include <sys/resource.h> // getrusage()
+
+#include <glib.h>
+#include <glib/gprintf.h> // g_ascii_strtod()
+
+#define  LOGI(...)  g_printerr(__VA_ARGS__)
+#define  LOGE(...)  g_printerr(__VA_ARGS__)
+
+#define WIDTH   1280
+#define HEIGHT  1024
+#define SCRIPT_DEFAULT_NLAST 10
+
+typedef struct EGLState {
+    EGLDisplay eglDisplay;
+    EGLSurface eglSurface;
+    EGLContext eglContext;
+} EGLState;
+
+typedef struct benchSet {
+    GArray *msec;        // double - time of each frame
+    double  total;
+} benchSet;
+
+static EGLState  _eglState = {EGL_NO_DISPLAY, EGL_NO_SURFACE, EGL_NO_CONTEXT};
+static GTimer   *_timer    = NULL;
+
+static benchSet  _draw;
+static benchSet  _last;
+static benchSet  _pick;
+
+static int       _width    = WIDTH;
+static int       _height   = HEIGHT;
+static char     *_dumpDir  = NULL;
+static guint     _nFrame   = 0;    // draw() + drawLast()
+static guint     _nFail    = 0;    // draw() + drawLast() that returned FALSE
+static guint     _nCmdFail = 0;    // script command that failed (frame included)
+
+static int      _egl_init       (EGLState *eglState, int w, int h)
+{
+    const EGLint eglConfigList[] = {
+        EGL_SURFACE_TYPE,    EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+        EGL_RED_SIZE,        8,
+        EGL_GREEN_SIZE,      8,
+        EGL_BLUE_SIZE,       8,
+        EGL_ALPHA_SIZE,      8,
+        EGL_STENCIL_SIZE,    8,
+        EGL_NONE
+    };
+    const EGLint eglPbufferList[] = {
+        EGL_WIDTH,  w,
+        EGL_HEIGHT, h,
+        EGL_NONE
+    };
+    const EGLint eglContextList[] = {
+        EGL_CONTEXT_CLIENT_VERSION, 2,
+        EGL_NONE
+    };
+
+    EGLint    major = 0;
+    EGLint    minor = 0;
+    EGLint    nConfig = 0;
+    EGLConfig eglConfig;
+
+    eglState->eglDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (EGL_NO_DISPLAY == eglState->eglDisplay) {
+        LOGE("_egl_init(): eglGetDisplay() failed. [0x%x]\n", eglGetError());
+        return FALSE;
+    }
+
+    if (EGL_FALSE == eglInitialize(eglState->eglDisplay, &major, &minor)) {
+        LOGE("_egl_init(): eglInitialize() failed. [0x%x]\n", eglGetError());
+        return FALSE;
+    }
+    LOGI("_egl_init(): EGL %i.%i, vendor: %s\n", major, minor, eglQueryString(eglState->eglDisplay, EGL_VENDOR));
+
+    if (EGL_FALSE == eglBindAPI(EGL_OPENGL_ES_API)) {
+        LOGE("_egl_init(): eglBindAPI() failed. [0x%x]\n", eglGetError());
+        return FALSE;
+    }
+
+    if ((EGL_FALSE==eglChooseConfig(eglState->eglDisplay, eglConfigList, &eglConfig, 1, &nConfig)) || (0==nConfig)) {
+        LOGE("_egl_init(): eglChooseConfig() failed. [0x%x]\n", eglGetError());
+        return FALSE;
+    }
+
+    eglState->eglSurface = eglCreatePbufferSurface(eglState->eglDisplay, eglConfig, eglPbufferList);
+    if (EGL_NO_SURFACE == eglState->eglSurface) {
+        LOGE("_egl_init(): eglCreatePbufferSurface() failed. [0x%x]\n", eglGetError());
+        return FALSE;
+    }
+
+    eglState->eglContext = eglCreateContext(eglState->eglDisplay, eglConfig, EGL_NO_CONTEXT, eglContextList);
+    if (EGL_NO_CONTEXT == eglState->eglContext) {
+        LOGE("_egl_init(): eglCreateContext() failed. [0x%x]\n", eglGetError());
+        return FALSE;
+    }
+
+    if (EGL_FALSE == eglMakeCurrent(eglState->eglDisplay, eglState->eglSurface, eglState->eglSurface, eglState->eglContext)) {
+        LOGE("_egl_init(): eglMakeCurrent() failed. [0x%x]\n", eglGetError());
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+static int      _egl_done       (EGLState *eglState)
+{
+    if (EGL_NO_DISPLAY == eglState->eglDisplay)
+        return FALSE;
+
+    eglMakeCurrent(eglState->eglDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+
+    if (EGL_NO_CONTEXT != eglState->eglContext)
+        eglDestroyContext(eglState->eglDisplay, eglState->eglContext);
+    if (EGL_NO_SURFACE != eglState->eglSurface)
+        eglDestroySurface(eglState->eglDisplay, eglState->eglSurface);
+
+    eglTerminate(eglState->eglDisplay);
+
+    eglState->eglDisplay = EGL_NO_DISPLAY;
+    eglState->eglSurface = EGL_NO_SURFACE;
+    eglState->eglContext = EGL_NO_CONTEXT;
+
+    return TRUE;
+}
+
+static int      _egl_beg        (EGLState *eglState, const char *tag)
+{
+    (void)tag;
+
+    if (eglState->eglContext != eglGetCurrentContext()) {
+        if (EGL_FALSE == eglMakeCurrent(eglState->eglDisplay, eglState->eglSurface, eglState->eglSurface, eglState->eglContext)) {
+            LOGE("_egl_beg(): eglMakeCurrent() failed. [0x%x]\n", eglGetError());
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+static int      _egl_end        (EGLState *eglState, const char *tag)
+{
+    (void)tag;
+
+    // no effect on a pbuffer, but make sure the GPU is done so the frame time is real
+    if (EGL_FALSE == eglWaitGL()) {
+        LOGE("_egl_end(): eglWaitGL() failed. [0x%x]\n", eglGetError());
+        return FALSE;
+    }
+
+    eglSwapBuffers(eglState->eglDisplay, eglState->eglSurface);
+
+    return TRUE;
+}
+
+static double   _lap            (void)
+// msec since last call
+{
+    double sec = g_timer_elapsed(_timer, NULL);
+    g_timer_reset(_timer);
+
+    return sec * 1000.0;
+}
+
+static int      _cmpDouble      (const void *a, const void *b)
+{
+    double da = *(const double*)a;
+    double db = *(const double*)b;
+
+    return (da < db) ? -1 : (da > db) ? 1 : 0;
+}
+
+static double   _percentile     (GArray *sorted, double p)
+// nearest-rank
+{
+    if (0 == sorted->len)
+        return 0.0;
+
+    guint i = (guint)(p / 100.0 * sorted->len + 0.5);
+    i = (0 == i) ? 0 : i - 1;
+    if (i >= sorted->len)
+        i = sorted->len - 1;
+
+    return g_array_index(sorted, double, i);
+}
+
+static int      _benchAdd       (benchSet *set, double msec)
+{
+    g_array_append_val(set->msec, msec);
+    set->total += msec;
+
+    return TRUE;
+}
+
+static int      _benchJSON      (FILE *out, const char *name, benchSet *set, int comma)
+{
+    GArray *sorted = set->msec;
+    double  mean   = (0 == sorted->len) ? 0.0 : set->total / sorted->len;
+
+    qsort(sorted->data, sorted->len, sizeof(double), _cmpDouble);
+
+    fprintf(out, "  \"%s\":{\"n\":%u,\"mean\":%.3f,\"min\":%.3f,\"p50\":%.3f,\"p90\":%.3f,\"p99\":%.3f,\"max\":%.3f}%s\n",
+            name, sorted->len, mean,
+            _percentile(sorted,   0.0),
+            _percentile(sorted,  50.0),
+            _percentile(sorted,  90.0),
+            _percentile(sorted,  99.0),
+            _percentile(sorted, 100.0),
+            (TRUE==comma) ? "," : "");
+
+    return TRUE;
+}
+
+static int      _dump           (const char *name)
+{
+    if (NULL == _dumpDir) {
+        LOGE("_dump(): no dump dir (-d) .. skip %s\n", name);
+        return FALSE;
+    }
+
+    gchar *fname = g_strdup_printf("%s/%s.png", _dumpDir, name);
+
+    // S57ID 0: whole framebuffer
+    int ret = S52_dumpS57IDPixels(fname, 0, _width, _height);
+    if (FALSE == ret)
+        LOGE("_dump(): S52_dumpS57IDPixels() failed .. %s\n", fname);
+
+    g_free(fname);
+
+    return ret;
+}
+
+static int      _runCmd         (gchar **tok, const char *line)
+{
+    double ms = 0.0;
+
+    if (0 == g_strcmp0(tok[0], "draw")) {
+        _lap();
+        if (FALSE == S52_draw()) {
+            ++_nFail;
+            LOGE("_runCmd(): S52_draw() failed\n");
+            return FALSE;
+        }
+        _benchAdd(&_draw, _lap());
+        ++_nFrame;
+        return TRUE;
+    }
+
+    if (0 == g_strcmp0(tok[0], "last")) {
+        _lap();
+        if (FALSE == S52_drawLast()) {
+            ++_nFail;
+            LOGE("_runCmd(): S52_drawLast() failed\n");
+            return FALSE;
+        }
+        _benchAdd(&_last, _lap());
+        ++_nFrame;
+        return TRUE;
+    }
+
+    if ((0==g_strcmp0(tok[0], "view")) && (5==g_strv_length(tok))) {
+        if (FALSE == S52_setView(g_ascii_strtod(tok[1], NULL), g_ascii_strtod(tok[2], NULL),
+                                 g_ascii_strtod(tok[3], NULL), g_ascii_strtod(tok[4], NULL))) {
+            LOGE("_runCmd(): S52_setView() failed: %s\n", line);
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    if ((0==g_strcmp0(tok[0], "mar")) && (3==g_strv_length(tok))) {
+        if (FALSE == S52_setMarinerParam((S52MarinerParameter)g_ascii_strtoll(tok[1], NULL, 10), g_ascii_strtod(tok[2], NULL))) {
+            LOGE("_runCmd(): S52_setMarinerParam() failed: %s\n", line);
+            return FALSE;
+        }
+        return TRUE;
+    }
+
+    if ((0==g_strcmp0(tok[0], "pick")) && (3==g_strv_length(tok))) {
+        _lap();
+        const char *name = S52_pickAt(g_ascii_strtod(tok[1], NULL), g_ascii_strtod(tok[2], NULL));
+        ms = _lap();
+        _benchAdd(&_pick, ms);
+        LOGI("_runCmd(): pick %s %s -> %s (%.3f msec)\n", tok[1], tok[2], (NULL==name) ? "NULL" : name, ms);
+        return TRUE;
+    }
+
+    if ((0==g_strcmp0(tok[0], "dump")) && (2==g_strv_length(tok))) {
+        return _dump(tok[1]);
+    }
+
+    LOGE("_runCmd(): unknown command: %s\n", line);
+
+    return FALSE;
+}
+
+static int      _runScript      (const char *script)
+{
+    gchar  *text  = NULL;
+    GError *error = NULL;
+
+    if (FALSE == g_file_get_contents(script, &text, NULL, &error)) {
+        LOGE("_runScript(): %s\n", error->message);
+        g_error_free(error);
+        return FALSE;
+    }
+
+    int     ret   = TRUE;
+    gchar **lines = g_strsplit(text, "\n", 0);
+    for (guint i=0; NULL!=lines[i]; ++i) {
+        gchar *line = g_strstrip(lines[i]);
+        if (('\0'==line[0]) || ('#'==line[0]))
+            continue;
+
+        gchar **tok = g_strsplit_set(line, " \t", 0);
+
+        // squeeze empty token (multiple blank)
+        guint n = 0;
+        for (guint j=0; NULL!=tok[j]; ++j) {
+            if ('\0' == tok[j][0])
+                g_free(tok[j]);
+            else
+                tok[n++] = tok[j];
+        }
+        tok[n] = NULL;
+
+        if (FALSE == _runCmd(tok, line)) {
+            ++_nCmdFail;
+            ret = FALSE;
+        }
+
+        g_strfreev(tok);
+    }
+
+    g_strfreev(lines);
+    g_free(text);
+
+    return ret;
+}
+
+static int      _runDefault     (void)
+{
+    gchar *tokDraw[] = {"draw", NULL};
+    gchar *tokLast[] = {"last", NULL};
+    int    ret       = TRUE;
+
+    if (FALSE == _runCmd(tokDraw, "draw")) {
+        ++_nCmdFail;
+        ret = FALSE;
+    }
+    for (int i=0; i<SCRIPT_DEFAULT_NLAST; ++i) {
+        if (FALSE == _runCmd(tokLast, "last")) {
+            ++_nCmdFail;
+            ret = FALSE;
+        }
+    }
+
+    return ret;
+}
+
+int main(int argc, char *argv[])
+{
+    gint         width   = WIDTH;
+    gint         height  = HEIGHT;
+    gint         repeat  = 1;
+    gchar       *script  = NULL;
+    gchar       *outName = NULL;
+    gchar       *dumpDir = NULL;
+    gchar      **cells   = NULL;
+    GError      *error   = NULL;
+
+    GOptionEntry entries[] = {
+        {"width",  'W', 0, G_OPTION_ARG_INT,            &width,   "pbuffer width  (pixels)",          "W"},
+        {"height", 'H', 0, G_OPTION_ARG_INT,            &height,  "pbuffer height (pixels)",          "H"},
+        {"script", 's', 0, G_OPTION_ARG_FILENAME,       &script,  "command script (see s52bench.c)",  "FILE"},
+        {"repeat", 'n', 0, G_OPTION_ARG_INT,            &repeat,  "run the script n times",           "N"},
+        {"out",    'o', 0, G_OPTION_ARG_FILENAME,       &outName, "JSON report file (default stdout)", "FILE"},
+        {"dump",   'd', 0, G_OPTION_ARG_FILENAME,       &dumpDir, "directory of PNG frame dump",      "DIR"},
+        {G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &cells, NULL, "[cell.000 ..]"},
+        {NULL, 0, 0, 0, NULL, NULL, NULL}
+    };
+
+    GOptionContext *ctx = g_option_context_new("- headless libS52 benchmark");
+    g_option_context_add_main_entries(ctx, entries, NULL);
+    if (FALSE == g_option_context_parse(ctx, &argc, &argv, &error)) {
+        LOGE("s52bench: %s\n", error->message);
+        g_error_free(error);
+        return 1;
+    }
+    g_option_context_free(ctx);
+
+    _width   = width;
+    _height  = height;
+    _dumpDir = dumpDir;
+
+    _draw.msec = g_array_new(FALSE, FALSE, sizeof(double));
+    _last.msec = g_array_new(FALSE, FALSE, sizeof(double));
+    _pick.msec = g_array_new(FALSE, FALSE, sizeof(double));
+
+    if (FALSE == _egl_init(&_eglState, _width, _height)) {
+        _egl_done(&_eglState);
+        return 1;
+    }
+
+    _timer = g_timer_new();
+
+    // no physical screen: assume 96 DPI
+    if (FALSE == S52_init(_width, _height, (int)(_width * 25.4 / 96.0), (int)(_height * 25.4 / 96.0), NULL)) {
+        LOGE("s52bench: S52_init(%i,%i) failed\n", _width, _height);
+        _egl_done(&_eglState);
+        return 1;
+    }
+
+    S52_setEGLCallBack((S52_EGL_cb)_egl_beg, (S52_EGL_cb)_egl_end, &_eglState);
+
+    // load
+    guint  nCell   = 0;
+    double loadMs  = 0.0;
+    _lap();
+    if (NULL == cells) {
+        if (TRUE == S52_loadCell(NULL, NULL))
+            ++nCell;
+    } else {
+        for (guint i=0; NULL!=cells[i]; ++i) {
+            if (TRUE == S52_loadCell(cells[i], NULL))
+                ++nCell;
+            else
+                LOGE("s52bench: S52_loadCell() failed: %s\n", cells[i]);
+        }
+    }
+    loadMs = _lap();
+
+    if (0 == nCell) {
+        LOGE("s52bench: no cell loaded .. exit\n");
+        S52_done();
+        _egl_done(&_eglState);
+        return 1;
+    }
+
+    // run
+    int runOK = TRUE;
+    _lap();
+    for (int r=0; r<repeat; ++r) {
+        int ret = (NULL == script) ? _runDefault() : _runScript(script);
+        if (FALSE == ret)
+            runOK = FALSE;
+    }
+
+    // report
+    FILE *out = stdout;
+    if (NULL != outName) {
+        out = fopen(outName, "w");
+        if (NULL == out) {
+            LOGE("s52bench: can't open %s .. use stdout\n", outName);
+            out = stdout;
+        }
+    }
+
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+
+    const char *stats = S52_getFrameStats(_nFrame);
+
+    fprintf(out, "{\n");
+    fprintf(out, "  \"width\":%i,\"height\":%i,\"repeat\":%i,\n", _width, _height, repeat);
+    fprintf(out, "  \"ncell\":%u,\"loadMsec\":%.3f,\n", nCell, loadMs);
+    fprintf(out, "  \"peakRSSkB\":%li,\n", usage.ru_maxrss);  // Linux: kB
+    fprintf(out, "  \"failFrame\":%u,\"failCmd\":%u,\n", _nFail, _nCmdFail);
+    _benchJSON(out, "draw",     &_draw, TRUE);
+    _benchJSON(out, "drawLast", &_last, TRUE);
+    _benchJSON(out, "pick",     &_pick, TRUE);
+    fprintf(out, "  \"frameStats\":%s\n", (NULL==stats) ? "null" : stats);
+    fprintf(out, "}\n");
+
+    if (stdout != out)
+        fclose(out);
+
+    S52_done();
+    _egl_done(&_eglState);
+
+    g_timer_destroy(_timer);
+    g_array_free(_draw.msec, TRUE);
+    g_array_free(_last.msec, TRUE);
+    g_array_free(_pick.msec, TRUE);
+    g_strfreev(cells);
+    g_free(script);
+    g_free(outName);
+    g_free(dumpDir);
+
+    if (FALSE == runOK) {
+        LOGE("s52bench: %u frame(s) and %u command(s) failed\n", _nFail, _nCmdFail);
+        return 1;
+    }
+
+    return 0;
+}